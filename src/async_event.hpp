@@ -0,0 +1,779 @@
+/**
+ * @file async_event.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (asynchronous dispatch)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "event.hpp"
+#include "object_pool.hpp"
+#include "thread_pool.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief What to do when dispatching to a full lane
+ *
+ */
+enum class overflow_policy
+{
+    /// @brief Wait for room in the lane
+    block,
+    /// @brief Discard the dispatched event data
+    drop_newest,
+    /// @brief Discard the oldest queued event data
+    drop_oldest,
+    /// @brief Replace queued event data having the same key (if any)
+    ///        or discard the oldest queued event data
+    conflate
+};
+
+/**
+ * @brief Overload counters of an asynchronous event
+ *
+ */
+struct async_statistics
+{
+    /// @brief Count of discarded event data
+    ::std::size_t dropped{0};
+    /// @brief Count of event data replaced by newer event data
+    ::std::size_t conflated{0};
+    /// @brief Total time spent by dispatchers waiting for room
+    ::std::chrono::nanoseconds blocked{0};
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Publish-subscribe event dispatched asynchronously
+ *
+ * @note Thread-safe
+ * @note Dispatching an event queues a copy of the event data,
+ *       which is delivered to all subscribed callbacks by an executor.
+ * @note Event data is queued in one of a number of *lanes*
+ *       depending on a key extracted from the event data.
+ *       Lanes are delivered in parallel, but event data in the same lane
+ *       (thus, having the same key) is delivered in dispatch order.
+ * @note Lanes are unbounded unless a capacity is set.
+ *       See set_capacity().
+ * @note Each lane may hold a number of priority levels.
+ *       See set_priorities().
+ * @note Batch callbacks receive all the event data taken from a lane
+ *       at once. See subscribe_batch().
+ * @note Queued event data is stored in per-thread pools (see object_pool),
+ *       so dispatching does not allocate memory once the pools of
+ *       the dispatching threads reach their peak size.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class async_event : private event<Args...>
+{
+    /// @brief Subscriber storage and synchronous dispatch
+    using base = event<Args...>;
+
+public:
+    /// @brief This type
+    using type = async_event<Args...>;
+    /// @brief Callback type
+    using typename base::callback_type;
+    /// @brief Subscription handler for managing callback lifetimes
+    using typename base::subscription_handler;
+    /// @brief Copy of the event data
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+    /// @brief Batch callback type
+    using batch_callback_type =
+        ::std::function<void(::std::span<const payload_type>)>;
+    /// @brief Subscription handler for batch callbacks
+    using batch_subscription_handler =
+        typename event<::std::span<const payload_type>>::subscription_handler;
+
+    using base::clear;
+    using base::emplace;
+    using base::subscribe;
+    using base::subscribed;
+    using base::unsubscribe;
+
+    /**
+     * @brief Subscribe forever
+     *
+     * @warning @p callback must exceed the lifetime of this instance
+     *
+     * @param callback Callback function to be called on event delivery
+     * @return type& This instance
+     */
+    type &operator+=(const callback_type &callback) noexcept
+    {
+        subscribe(callback);
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     *
+     * @param h Subscription handler returned by subscribe()
+     * @return type& This instance
+     */
+    type &operator-=(subscription_handler &h) noexcept
+    {
+        unsubscribe(h);
+        return *this;
+    }
+
+    /// @brief Maximum count of event data taken from a lane at once
+    ///        (and so, maximum size of a batch)
+    static constexpr ::std::size_t batch_limit = 256;
+
+    /**
+     * @brief Subscribe a batch callback
+     *
+     * @note @p callback receives contiguous event data in delivery order,
+     *       as much as it is queued at the time of delivery
+     *       up to @p max_batch items.
+     * @note Batches never exceed batch_limit items,
+     *       whatever @p max_batch is. Event data is taken from the
+     *       queues in chunks of that size at most, so other callbacks
+     *       do not wait for a long batch to be collected.
+     *
+     * @param callback Callback function to be called on event delivery
+     * @param max_batch Maximum count of event data per call.
+     *                  Zero means no limit other than batch_limit.
+     * @return batch_subscription_handler Handler required to unsubscribe
+     */
+    batch_subscription_handler subscribe_batch(
+        const batch_callback_type &callback,
+        ::std::size_t max_batch = 0) noexcept
+    {
+        if (!callback || (max_batch == 0))
+            return _batch_subscribers.subscribe(callback);
+        return _batch_subscribers.subscribe(
+            [callback, max_batch](::std::span<const payload_type> batch)
+            {
+                while (batch.size() > max_batch)
+                {
+                    callback(batch.first(max_batch));
+                    batch = batch.subspan(max_batch);
+                }
+                callback(batch);
+            });
+    }
+
+    /**
+     * @brief Unsubscribe a batch callback
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     *
+     * @param h Subscription handler returned by subscribe_batch()
+     */
+    void unsubscribe(batch_subscription_handler &h) noexcept
+    {
+        _batch_subscribers.unsubscribe(h);
+    }
+
+    /**
+     * @brief Dispatch event to all subscribed callbacks (asynchronously)
+     *
+     * @note Lowest priority
+     *
+     * @param args Event data
+     */
+    void operator()(const Args &...args)
+    {
+        dispatch(0, args...);
+    }
+
+    /**
+     * @brief Dispatch event to all subscribed callbacks (asynchronously)
+     *
+     * @param priority Priority level. Zero is the lowest priority.
+     *                 Out of range values are taken as the highest priority.
+     * @param args Event data
+     */
+    void dispatch(::std::size_t priority, const Args &...args)
+    {
+        ::std::size_t hash = _hash ? _hash(args...) : 0;
+        lane &target = _lanes[hash % _lane_count];
+        bool schedule;
+        {
+            ::std::unique_lock<::std::mutex> guard(target.mutex);
+            if (priority >= target.queues.size())
+                priority = target.queues.size() - 1;
+            if (!enqueue(target, target.queues[priority], guard, hash, args...))
+                return;
+            schedule = !target.scheduled;
+            target.scheduled = true;
+        }
+        if (schedule)
+        {
+            {
+                ::std::lock_guard<::std::mutex> guard(idle_mutex);
+                _active++;
+            }
+            _executor.post([this, &target]()
+                           { drain(target); });
+        }
+    }
+
+    /**
+     * @brief Wait for all queued event data to be delivered
+     *
+     * @note Does not prevent further dispatching
+     */
+    void wait()
+    {
+        ::std::unique_lock<::std::mutex> guard(idle_mutex);
+        idle.wait(guard, [this]()
+                  { return (_active == 0); });
+    }
+
+    /**
+     * @brief Set strict priority levels
+     *
+     * @note Queued event data is delivered from the highest non-empty
+     *       priority level first.
+     * @warning Must be called before dispatching
+     *
+     * @param levels Count of priority levels
+     */
+    void set_priorities(::std::size_t levels)
+    {
+        set_priorities(::std::vector<unsigned int>(levels ? levels : 1, 0));
+    }
+
+    /**
+     * @brief Set weighted priority levels
+     *
+     * @note Priority levels are served in turn from the highest to the lowest,
+     *       delivering up to the given weight of queued event data each turn.
+     *       Zero weights are taken as one, but all-zero weights mean
+     *       strict priority.
+     * @warning Must be called before dispatching
+     *
+     * @param weights Weight of each priority level, from lowest to highest
+     */
+    void set_priorities(::std::vector<unsigned int> weights)
+    {
+        if (weights.empty())
+            weights.push_back(0);
+        bool strict = true;
+        for (auto weight : weights)
+            strict = strict && (weight == 0);
+        if (!strict)
+            for (auto &weight : weights)
+                weight = weight ? weight : 1;
+        for (::std::size_t index = 0; index < _lane_count; index++)
+        {
+            ::std::lock_guard<::std::mutex> guard(_lanes[index].mutex);
+            _lanes[index].queues.resize(weights.size());
+            _lanes[index].weights = weights;
+            _lanes[index].strict = strict;
+            _lanes[index].turn = weights.size() - 1;
+            _lanes[index].served = 0;
+            _lanes[index].reindex();
+        }
+    }
+
+    /**
+     * @brief Bound the count of queued event data in each lane
+     *
+     * @warning Using overflow_policy::block, dispatching from
+     *          the executor's thread may deadlock
+     *
+     * @note Without a key extractor, all event data has the same key
+     *       for overflow_policy::conflate
+     *
+     * @param capacity Maximum count of queued event data
+     *                 per lane and priority level.
+     *                 Zero means unbounded.
+     * @param policy What to do when dispatching to a full lane
+     */
+    void set_capacity(
+        ::std::size_t capacity,
+        overflow_policy policy = overflow_policy::block)
+    {
+        for (::std::size_t index = 0; index < _lane_count; index++)
+        {
+            ::std::lock_guard<::std::mutex> guard(_lanes[index].mutex);
+            _lanes[index].capacity = capacity;
+            _lanes[index].policy = policy;
+            _lanes[index].reindex();
+            _lanes[index].not_full.notify_all();
+        }
+    }
+
+    /**
+     * @brief Get overload counters
+     *
+     * @return async_statistics Counters summed across all lanes
+     */
+    async_statistics statistics() const
+    {
+        async_statistics result{};
+        for (::std::size_t index = 0; index < _lane_count; index++)
+        {
+            ::std::lock_guard<::std::mutex> guard(_lanes[index].mutex);
+            result.dropped += _lanes[index].counters.dropped;
+            result.conflated += _lanes[index].counters.conflated;
+            result.blocked += _lanes[index].counters.blocked;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the number of lanes
+     *
+     * @return ::std::size_t Count of lanes
+     */
+    ::std::size_t lanes() const noexcept
+    {
+        return _lane_count;
+    }
+
+    /**
+     * @brief Create an asynchronous event with a single lane
+     *
+     * @note Event data is delivered in dispatch order
+     *
+     * @param target Executor where callbacks are called
+     */
+    explicit async_event(executor &target = thread_pool::shared())
+        : _executor{target},
+          _lanes{::std::make_unique<lane[]>(1)},
+          _lane_count{1} {}
+
+    /**
+     * @brief Create an asynchronous event partitioned in lanes
+     *
+     * @note Event data having the same key is delivered in dispatch order
+     *
+     * @tparam KeyFn Key extractor type
+     * @param lanes Count of lanes (for example, count of worker threads)
+     * @param key Key extractor: takes the event data and returns a hashable key
+     * @param target Executor where callbacks are called
+     */
+    template <class KeyFn>
+    async_event(
+        ::std::size_t lanes,
+        KeyFn key,
+        executor &target = thread_pool::shared())
+        : _executor{target},
+          _lanes{::std::make_unique<lane[]>(lanes ? lanes : 1)},
+          _lane_count{lanes ? lanes : 1}
+    {
+        using key_type =
+            ::std::decay_t<::std::invoke_result_t<KeyFn, const Args &...>>;
+        _hash = [key](const Args &...args) -> ::std::size_t
+        {
+            return ::std::hash<key_type>{}(::std::invoke(key, args...));
+        };
+        _same_key = [key](const payload_type &a, const payload_type &b) -> bool
+        {
+            return (::std::apply(key, a) == ::std::apply(key, b));
+        };
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * @note Waits for all queued event data to be delivered
+     */
+    ~async_event() noexcept
+    {
+        wait();
+    }
+
+    /// @brief Copy constructor (deleted)
+    async_event(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /// @brief Queued event data
+    struct queued
+    {
+        /// @brief Event data
+        payload_type payload;
+        /// @brief Hash of the key
+        ::std::size_t hash;
+    };
+
+    /// @brief Pool of queued event data
+    using pool_type = object_pool<queued>;
+
+    /// @brief Queue of event data (first in, first out)
+    class queue_type
+    {
+    public:
+        /// @brief Node of this queue
+        using node = typename pool_type::node;
+
+        /// @brief Default constructor
+        queue_type() noexcept = default;
+
+        /// @brief Move constructor
+        /// @param source Rvalue
+        queue_type(queue_type &&source) noexcept
+            : head{source.head}, tail{source.tail}, count{source.count},
+              index{::std::move(source.index)}
+        {
+            source.head = source.tail = nullptr;
+            source.count = 0;
+        }
+
+        /// @brief Copy constructor (deleted)
+        queue_type(const queue_type &) = delete;
+        /// @brief Copy-assignment (deleted)
+        queue_type &operator=(const queue_type &) = delete;
+
+        /// @brief Return all nodes to their pools
+        ~queue_type() noexcept
+        {
+            while (head)
+                pop_front();
+        }
+
+        /// @brief Check if empty
+        bool empty() const noexcept
+        {
+            return (head == nullptr);
+        }
+
+        /// @brief Get the count of queued event data
+        ::std::size_t size() const noexcept
+        {
+            return count;
+        }
+
+        /// @brief Get the oldest event data
+        queued &front() noexcept
+        {
+            return head->value();
+        }
+
+        /// @brief Queue event data
+        void push_back(queued &&item)
+        {
+            node *added = pool_type::acquire(::std::move(item));
+            if (tail)
+                tail->next = added;
+            else
+                head = added;
+            tail = added;
+            count++;
+            if (index)
+                index->nodes.emplace(added->value().hash, added);
+        }
+
+        /// @brief Discard the oldest event data
+        void pop_front() noexcept
+        {
+            node *removed = head;
+            head = head->next;
+            if (!head)
+                tail = nullptr;
+            count--;
+            if (index)
+                index->erase(removed);
+            pool_type::release(removed);
+        }
+
+        /**
+         * @brief Index queued event data by hash of the key
+         *
+         * @param enable True to index, false to drop the index
+         */
+        void set_indexed(bool enable)
+        {
+            if (!enable)
+                index.reset();
+            else if (!index)
+            {
+                index = ::std::make_unique<key_index>();
+                for (node *item = head; item; item = item->next)
+                    index->nodes.emplace(item->value().hash, item);
+            }
+        }
+
+        /**
+         * @brief Find queued event data having the same key
+         *
+         * @note Constant time (on average) if indexed, linear otherwise
+         *
+         * @tparam Pred Key comparison type
+         * @param hash Hash of the key
+         * @param same_key Key comparison of queued event data
+         * @return queued* Matching event data or null if not found
+         */
+        template <class Pred>
+        queued *find(::std::size_t hash, Pred &&same_key)
+        {
+            if (index)
+            {
+                // Note: several nodes only if the hashes of different keys collide
+                auto [first, last] = index->nodes.equal_range(hash);
+                for (auto it = first; it != last; ++it)
+                    if (same_key(it->second->value()))
+                        return &it->second->value();
+                return nullptr;
+            }
+            for (node *item = head; item; item = item->next)
+                if ((item->value().hash == hash) && same_key(item->value()))
+                    return &item->value();
+            return nullptr;
+        }
+
+    private:
+        /// @brief Nodes by hash of the key
+        struct key_index
+        {
+            /// @brief Recycled memory for the nodes of the map,
+            ///        so indexing does not allocate in the steady state
+            ::std::pmr::unsynchronized_pool_resource pool{};
+            /// @brief Queued nodes by hash of the key
+            ::std::pmr::unordered_multimap<::std::size_t, node *> nodes{&pool};
+
+            /// @brief Remove a node
+            void erase(node *item) noexcept
+            {
+                auto [first, last] = nodes.equal_range(item->value().hash);
+                for (auto it = first; it != last; ++it)
+                    if (it->second == item)
+                    {
+                        nodes.erase(it);
+                        return;
+                    }
+            }
+        };
+
+        /// @brief Oldest node
+        node *head{nullptr};
+        /// @brief Newest node
+        node *tail{nullptr};
+        /// @brief Count of nodes
+        ::std::size_t count{0};
+        /// @brief Index by hash of the key (conflating only)
+        ::std::unique_ptr<key_index> index{};
+    };
+
+    /// @brief Queues of event data (one per priority level)
+    struct lane
+    {
+        /// @brief Event data taken from the queues for delivery
+        ::std::vector<payload_type> batch{};
+        /// @brief Queued event data per priority level
+        ::std::vector<queue_type> queues = ::std::vector<queue_type>(1);
+        /// @brief Weight of each priority level
+        ::std::vector<unsigned int> weights = ::std::vector<unsigned int>(1, 0);
+        /// @brief True for strict priority, false for weighted
+        bool strict{true};
+        /// @brief Priority level in turn (weighted only)
+        ::std::size_t turn{0};
+        /// @brief Event data delivered in this turn (weighted only)
+        unsigned int served{0};
+        /// @brief True if a drain task is posted or running
+        bool scheduled{false};
+        /// @brief Maximum queue size (zero means unbounded)
+        ::std::size_t capacity{0};
+        /// @brief What to do when the queue is full
+        overflow_policy policy{overflow_policy::block};
+        /// @brief Overload counters
+        async_statistics counters{};
+        /// @brief Mutex for thread-safe operations
+        mutable ::std::mutex mutex{};
+        /// @brief Signaled when event data is taken from the queue
+        ::std::condition_variable not_full{};
+
+        /// @brief Index queued event data by key if conflating
+        void reindex()
+        {
+            for (auto &queue : queues)
+                queue.set_indexed(policy == overflow_policy::conflate);
+        }
+
+        /// @brief Check if a queue is full
+        bool full(const queue_type &queue) const noexcept
+        {
+            return (capacity > 0) && (queue.size() >= capacity);
+        }
+
+        /// @brief Select the queue to deliver from
+        /// @return queue_type* Queue or null if all are empty
+        queue_type *next() noexcept
+        {
+            if (strict)
+            {
+                // Strict priority
+                for (::std::size_t level = queues.size(); level > 0; level--)
+                    if (!queues[level - 1].empty())
+                        return &queues[level - 1];
+                return nullptr;
+            }
+
+            // Weighted round-robin
+            for (::std::size_t attempt = 0; attempt <= queues.size(); attempt++)
+            {
+                if (!queues[turn].empty() && (served < weights[turn]))
+                {
+                    served++;
+                    return &queues[turn];
+                }
+                turn = (turn == 0) ? (queues.size() - 1) : (turn - 1);
+                served = 0;
+            }
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief Queue event data in a lane according to its overflow policy
+     *
+     * @param target Lane
+     * @param queue Queue in @p target for the priority level
+     * @param guard Lock on the lane's mutex
+     * @param hash Hash of the key
+     * @param args Event data
+     * @return true if queued
+     * @return false if discarded or conflated
+     */
+    bool enqueue(
+        lane &target,
+        queue_type &queue,
+        ::std::unique_lock<::std::mutex> &guard,
+        ::std::size_t hash,
+        const Args &...args)
+    {
+        if (target.policy == overflow_policy::conflate)
+        {
+            payload_type payload(args...);
+            queued *found = queue.find(
+                hash,
+                [this, &payload](const queued &item)
+                {
+                    return !_same_key || _same_key(item.payload, payload);
+                });
+            if (found)
+            {
+                found->payload = ::std::move(payload);
+                target.counters.conflated++;
+                return false;
+            }
+            if (target.full(queue))
+            {
+                queue.pop_front();
+                target.counters.dropped++;
+            }
+            queue.push_back({::std::move(payload), hash});
+            return true;
+        }
+
+        if (target.full(queue))
+            switch (target.policy)
+            {
+            case overflow_policy::drop_newest:
+                target.counters.dropped++;
+                return false;
+            case overflow_policy::drop_oldest:
+                queue.pop_front();
+                target.counters.dropped++;
+                break;
+            default:
+            {
+                auto start = ::std::chrono::steady_clock::now();
+                target.not_full.wait(guard, [&target, &queue]()
+                                     { return !target.full(queue); });
+                target.counters.blocked +=
+                    ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
+                        ::std::chrono::steady_clock::now() - start);
+            }
+            }
+        queue.push_back({payload_type(args...), hash});
+        return true;
+    }
+
+    /**
+     * @brief Deliver queued event data until the lane is empty
+     *
+     * @note Executed by the executor
+     *
+     * @param source Lane
+     */
+    void drain(lane &source)
+    {
+        // Note: a lane is drained by a single task at a time,
+        // so source.batch is not shared
+        while (true)
+        {
+            source.batch.clear();
+            {
+                ::std::lock_guard<::std::mutex> guard(source.mutex);
+                while (source.batch.size() < batch_limit)
+                {
+                    queue_type *queue = source.next();
+                    if (!queue)
+                        break;
+                    source.batch.push_back(::std::move(queue->front().payload));
+                    queue->pop_front();
+                }
+                if (source.batch.empty())
+                {
+                    source.scheduled = false;
+                    break;
+                }
+            }
+            source.not_full.notify_all();
+            for (const auto &item : source.batch)
+                ::std::apply(
+                    [this](const auto &...data)
+                    { base::operator()(data...); },
+                    item);
+            _batch_subscribers(::std::span<const payload_type>(source.batch));
+        }
+
+        // Note: this instance may be destroyed as soon as idle_mutex is released
+        ::std::lock_guard<::std::mutex> guard(idle_mutex);
+        if (--_active == 0)
+            idle.notify_all();
+    }
+
+    /// @brief Batch callbacks
+    event<::std::span<const payload_type>> _batch_subscribers{};
+    /// @brief Executor where callbacks are called
+    executor &_executor;
+    /// @brief Lanes
+    ::std::unique_ptr<lane[]> _lanes;
+    /// @brief Count of lanes
+    ::std::size_t _lane_count;
+    /// @brief Hash of the key of some event data (if partitioned)
+    ::std::function<::std::size_t(const Args &...)> _hash{};
+    /// @brief Key comparison of queued event data (if partitioned)
+    ::std::function<bool(const payload_type &, const payload_type &)> _same_key{};
+    /// @brief Count of lanes being drained
+    ::std::size_t _active{0};
+    /// @brief Mutex for _active
+    ::std::mutex idle_mutex{};
+    /// @brief Signaled when no lane is being drained
+    ::std::condition_variable idle{};
+};
+
+//------------------------------------------------------------------------------
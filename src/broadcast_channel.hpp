@@ -0,0 +1,383 @@
+/**
+ * @file broadcast_channel.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (one producer, many consumer threads)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "wait_strategy.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Broadcast of event data to consumer threads through a ring buffer
+ *
+ * @note Event data is copied once into a preallocated ring of slots.
+ *       Every subscribed callback runs in its own consumer thread,
+ *       which reads all the event data from the ring in publication order
+ *       at its own pace.
+ * @note Publishing waits for the slowest consumer when the ring is full,
+ *       so no event data is lost.
+ * @note A single thread may publish at a time.
+ *       Subscribing and unsubscribing are thread-safe.
+ * @note Callbacks must not throw exceptions.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class broadcast_channel
+{
+public:
+    /// @brief This type
+    using type = broadcast_channel<Args...>;
+    /// @brief Callback type
+    using callback_type = typename ::std::function<void(Args...)>;
+    /// @brief Copy of the event data
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+
+    /**
+     * @brief Subscription handler for managing consumer lifetimes
+     *
+     * @note Invalid after callback is unsubscribed
+     */
+    class subscription_handler
+    {
+        friend class broadcast_channel<Args...>;
+        /// @brief Pointer to owning channel instance
+        void *owner{nullptr};
+        /// @brief Subscription id
+        ::std::size_t id{0};
+
+        /**
+         * @brief Private constructor
+         * @param owner Owning channel instance
+         * @param id Subscription id
+         */
+        constexpr subscription_handler(void *owner, ::std::size_t id) noexcept
+            : owner{owner}, id{id} {}
+
+    public:
+        /**
+         * @brief Check if subscribed
+         *
+         * @return true if subscribed
+         * @return false otherwise
+         */
+        constexpr bool is_subscribed() const noexcept
+        {
+            return (owner != nullptr);
+        }
+
+        /// @brief Default constructor
+        constexpr subscription_handler() noexcept = default;
+        /// @brief Move constructor (default)
+        constexpr subscription_handler(
+            subscription_handler &&) noexcept = default;
+        /// @brief Copy constructor (deleted)
+        constexpr subscription_handler(
+            const subscription_handler &) noexcept = delete;
+        /// @brief Move-assignment (default)
+        constexpr subscription_handler &operator=(
+            subscription_handler &&) noexcept = default;
+        /// @brief Copy-assignment (deleted)
+        constexpr subscription_handler &operator=(
+            const subscription_handler &) noexcept = delete;
+    };
+
+    /**
+     * @brief Subscribe a callback function in a new consumer thread
+     *
+     * @note @p callback receives event data published after subscription
+     *
+     * @param callback Callback function to be called on event delivery
+     * @return subscription_handler Handler required to unsubscribe
+     */
+    subscription_handler subscribe(const callback_type &callback)
+    {
+        if (!callback)
+            return subscription_handler();
+
+        ::std::unique_lock<::std::shared_mutex> guard(consumers_mutex);
+        auto added = ::std::make_unique<consumer>();
+        added->cursor.store(
+            _published.load(::std::memory_order_seq_cst),
+            ::std::memory_order_seq_cst);
+        added->callback = callback;
+        added->id = next_id++;
+        consumer &target = *added;
+        _consumers.push_back(::std::move(added));
+        target.thread = ::std::thread(&type::consume, this, ::std::ref(target));
+        return subscription_handler(this, target.id);
+    }
+
+    /**
+     * @brief Subscribe forever
+     *
+     * @note Use subscribe() instead if you need to unsubscribe later
+     *
+     * @param callback Callback function to be called on event delivery
+     * @return type& This instance
+     */
+    type &operator+=(const callback_type &callback)
+    {
+        subscribe(callback);
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe and join the consumer thread
+     *
+     * @note Queued event data not yet delivered to the consumer is skipped
+     * @note No effect if @p h is invalid or already unsubscribed
+     * @warning Must not be called from the consumer's own callback
+     *
+     * @param h Subscription handler returned by subscribe()
+     */
+    void unsubscribe(subscription_handler &h)
+    {
+        if (h.owner != this)
+            return;
+
+        ::std::unique_ptr<consumer> removed;
+        {
+            ::std::unique_lock<::std::shared_mutex> guard(consumers_mutex);
+            for (auto c = _consumers.begin(); c != _consumers.end(); ++c)
+                if ((*c)->id == h.id)
+                {
+                    removed = ::std::move(*c);
+                    _consumers.erase(c);
+                    break;
+                }
+        }
+        h.owner = nullptr;
+        if (removed)
+            stop(*removed);
+        // The producer may be waiting for the removed consumer
+        _consumed_point.notify();
+    }
+
+    /**
+     * @brief Publish event data to all consumers
+     *
+     * @note Waits for the slowest consumer if the ring is full
+     *
+     * @param args Event data
+     */
+    void operator()(const Args &...args)
+    {
+        ::std::int64_t sequence = _next;
+        ::std::int64_t wrap = sequence - static_cast<::std::int64_t>(_capacity);
+        if (wrap > _gate)
+        {
+            // Note: the slowest consumer is cached to avoid
+            // reading all cursors on every publication
+            _producer.wait(
+                _consumed_point,
+                [this, wrap]()
+                {
+                    _gate = slowest();
+                    return (wrap <= _gate);
+                });
+        }
+        _slots[sequence & _mask].emplace(args...);
+        _published.store(sequence, ::std::memory_order_seq_cst);
+        _published_point.notify();
+        _next++;
+    }
+
+    /**
+     * @brief Wait for all published event data to be consumed
+     *
+     * @note Does not prevent further publishing
+     */
+    void wait()
+    {
+        waiter(_producer.strategy())
+            .wait(
+                _consumed_point,
+                [this]()
+                {
+                    return (slowest() >= _published.load(::std::memory_order_seq_cst));
+                });
+    }
+
+    /**
+     * @brief Get the number of consumers
+     *
+     * @return ::std::size_t Count of subscribed callbacks
+     */
+    ::std::size_t subscribed() const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(consumers_mutex);
+        return _consumers.size();
+    }
+
+    /**
+     * @brief Get the size of the ring
+     *
+     * @return ::std::size_t Count of slots
+     */
+    ::std::size_t capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief Create a broadcast channel
+     *
+     * @param capacity Count of slots in the ring
+     *                 (rounded up to a power of two)
+     * @param strategy How producer and consumers wait for each other
+     */
+    explicit broadcast_channel(
+        ::std::size_t capacity = 1024,
+        wait_strategy strategy = wait_strategy::block)
+        : _capacity{::std::bit_ceil(::std::max<::std::size_t>(capacity, 1))},
+          _mask{_capacity - 1},
+          _slots{::std::make_unique<::std::optional<payload_type>[]>(_capacity)},
+          _producer{strategy} {}
+
+    /**
+     * @brief Destructor
+     *
+     * @note Waits for all published event data to be consumed,
+     *       then joins all consumer threads
+     */
+    ~broadcast_channel() noexcept
+    {
+        wait();
+        ::std::vector<::std::unique_ptr<consumer>> removed;
+        {
+            ::std::unique_lock<::std::shared_mutex> guard(consumers_mutex);
+            removed.swap(_consumers);
+        }
+        for (auto &c : removed)
+            stop(*c);
+    }
+
+    /// @brief Copy constructor (deleted)
+    broadcast_channel(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /// @brief Consumer thread and its position in the ring
+    struct consumer
+    {
+        /// @brief Sequence of the last consumed event data
+        alignas(64) ::std::atomic<::std::int64_t> cursor{-1};
+        /// @brief True to stop the consumer thread
+        ::std::atomic<bool> stopping{false};
+        /// @brief Subscription id
+        ::std::size_t id{0};
+        /// @brief Callback
+        callback_type callback{};
+        /// @brief Consumer thread
+        ::std::thread thread{};
+    };
+
+    /**
+     * @brief Consumer thread body
+     *
+     * @param self Consumer
+     */
+    void consume(consumer &self)
+    {
+        waiter wait_for_data(_producer.strategy());
+        ::std::int64_t next = self.cursor.load(::std::memory_order_relaxed) + 1;
+        while (true)
+        {
+            ::std::int64_t available;
+            wait_for_data.wait(
+                _published_point,
+                [this, &self, &available, next]()
+                {
+                    available = _published.load(::std::memory_order_seq_cst);
+                    return (available >= next) ||
+                           self.stopping.load(::std::memory_order_seq_cst);
+                });
+            if (self.stopping.load(::std::memory_order_relaxed))
+                break;
+            for (; next <= available; next++)
+                ::std::apply(self.callback, *_slots[next & _mask]);
+            // Note: the cursor is published once per batch
+            self.cursor.store(available, ::std::memory_order_seq_cst);
+            _consumed_point.notify();
+        }
+    }
+
+    /**
+     * @brief Stop and join a consumer thread
+     *
+     * @param target Consumer (already removed from the list)
+     */
+    void stop(consumer &target)
+    {
+        target.stopping.store(true, ::std::memory_order_seq_cst);
+        _published_point.notify();
+        target.thread.join();
+    }
+
+    /**
+     * @brief Get the sequence of the slowest consumer
+     *
+     * @return ::std::int64_t Lowest consumer cursor
+     *         (or the last published sequence if no consumers)
+     */
+    ::std::int64_t slowest() const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(consumers_mutex);
+        ::std::int64_t result = _published.load(::std::memory_order_seq_cst);
+        for (const auto &c : _consumers)
+            result = ::std::min(result, c->cursor.load(::std::memory_order_seq_cst));
+        return result;
+    }
+
+    /// @brief Count of slots (power of two)
+    ::std::size_t _capacity;
+    /// @brief Capacity minus one
+    ::std::size_t _mask;
+    /// @brief Ring of slots
+    ::std::unique_ptr<::std::optional<payload_type>[]> _slots;
+    /// @brief Sequence of the last published event data
+    alignas(64) ::std::atomic<::std::int64_t> _published{-1};
+    /// @brief Sequence of the next event data (producer only)
+    alignas(64) ::std::int64_t _next{0};
+    /// @brief Cached sequence of the slowest consumer (producer only)
+    ::std::int64_t _gate{-1};
+    /// @brief Producer's waiter
+    waiter _producer;
+    /// @brief Where consumers wait for publication
+    wait_point _published_point{};
+    /// @brief Where the producer waits for consumption
+    wait_point _consumed_point{};
+    /// @brief Consumers
+    ::std::vector<::std::unique_ptr<consumer>> _consumers{};
+    /// @brief Next subscription id
+    ::std::size_t next_id{0};
+    /// @brief Mutex for the list of consumers
+    mutable ::std::shared_mutex consumers_mutex{};
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,341 @@
+/**
+ * @file bucket_event.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <typeinfo>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Publish-subscribe event (subscribers grouped by callable type)
+ *
+ * @note Thread-safe
+ * @note Callbacks of the same type are stored together and called
+ *       in a loop without type erasure, so the compiler is able to inline
+ *       the callback body. Callbacks of different types are called in order
+ *       of their first subscription.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class bucket_event
+{
+public:
+    /// @brief This type
+    using type = bucket_event<Args...>;
+
+    /**
+     * @brief Subscription handler for managing callback lifetimes
+     *
+     * @note Invalid after callback is unsubscribed
+     */
+    class subscription_handler
+    {
+        friend class bucket_event<Args...>;
+        /// @brief Pointer to owning event instance
+        void *owner{nullptr};
+        /// @brief Subscription id
+        ::std::size_t id{0};
+
+        /**
+         * @brief Private constructor
+         * @param owner Owning event instance
+         * @param id Subscription id
+         */
+        constexpr subscription_handler(void *owner, ::std::size_t id) noexcept
+            : owner{owner}, id{id} {}
+
+    public:
+        /**
+         * @brief Check if subscribed
+         *
+         * @return true if subscribed
+         * @return false otherwise
+         */
+        constexpr bool is_subscribed() const noexcept
+        {
+            return (owner != nullptr);
+        }
+
+        /// @brief Default constructor
+        constexpr subscription_handler() noexcept = default;
+        /// @brief Move constructor (default)
+        constexpr subscription_handler(
+            subscription_handler &&) noexcept = default;
+        /// @brief Copy constructor (deleted)
+        constexpr subscription_handler(
+            const subscription_handler &) noexcept = delete;
+        /// @brief Move-assignment (default)
+        constexpr subscription_handler &operator=(
+            subscription_handler &&) noexcept = default;
+        /// @brief Copy-assignment (deleted)
+        constexpr subscription_handler &operator=(
+            const subscription_handler &) noexcept = delete;
+    };
+
+    /**
+     * @brief Subscribe a callable object
+     *
+     * @tparam F Callable object type
+     * @param callable Callable object to be called on event dispatch
+     * @return subscription_handler Handler required to unsubscribe
+     */
+    template <class F>
+    subscription_handler subscribe(F &&callable) noexcept
+    {
+        using callable_type = ::std::decay_t<F>;
+        if constexpr (::std::is_pointer_v<::std::remove_reference_t<F>>)
+            if (!callable)
+                return subscription_handler();
+
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        bucket<callable_type> *target = nullptr;
+        for (auto &b : _buckets)
+            if (b->holds(typeid(callable_type)))
+            {
+                target = static_cast<bucket<callable_type> *>(b.get());
+                break;
+            }
+        if (!target)
+        {
+            auto new_bucket = ::std::make_unique<bucket<callable_type>>();
+            target = new_bucket.get();
+            _buckets.push_back(::std::move(new_bucket));
+        }
+        target->callables.emplace_back(::std::forward<F>(callable));
+        target->ids.push_back(next_id);
+        return subscription_handler(this, next_id++);
+    }
+
+    /**
+     * @brief Subscribe forever
+     *
+     * @warning @p callable must exceed the lifetime of this instance
+     *
+     * @note Use subscribe() instead if you need to unsubscribe later
+     *
+     * @tparam F Callable object type
+     * @param callable Callable object to be called on event dispatch
+     * @return type& This instance
+     */
+    template <class F>
+    type &operator+=(F &&callable) noexcept
+    {
+        subscribe(::std::forward<F>(callable));
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     *
+     * @param h Subscription handler returned by subscribe()
+     */
+    void unsubscribe(subscription_handler &h) noexcept
+    {
+        if (h.owner != this)
+            return;
+
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        for (auto b = _buckets.begin(); b != _buckets.end(); ++b)
+            if ((*b)->erase(h.id))
+            {
+                if ((*b)->size() == 0)
+                    _buckets.erase(b);
+                break;
+            }
+        h.owner = nullptr;
+    }
+
+    /**
+     * @brief Unsubscribe
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     * @note An alias for unsubscribe()
+     *
+     * @param h Subscription handler returned by subscribe()
+     * @return type& This instance
+     */
+    type &operator-=(subscription_handler &h) noexcept
+    {
+        unsubscribe(h);
+        return *this;
+    }
+
+    /**
+     * @brief Clear all subscriptions
+     *
+     * @warning To be used exclusively in test units.
+     */
+    void clear() noexcept
+    {
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        _buckets.clear();
+    }
+
+    /**
+     * @brief Dispatch event to all subscribed callbacks
+     *
+     * @param args Event data
+     */
+    void operator()(const Args &...args) const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        for (const auto &b : _buckets)
+            b->dispatch(args...);
+    }
+
+    /**
+     * @brief Get the number of subscribed callbacks
+     *
+     * @return ::std::size_t Count of subscribed callbacks
+     */
+    ::std::size_t subscribed() const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        ::std::size_t count = 0;
+        for (const auto &b : _buckets)
+            count += b->size();
+        return count;
+    }
+
+    /**
+     * @brief Get the number of distinct callable types subscribed
+     *
+     * @return ::std::size_t Count of buckets
+     */
+    ::std::size_t buckets() const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        return _buckets.size();
+    }
+
+    /**
+     * @brief Move-assignment
+     *
+     * @param source Rvalue
+     * @return type& Reference to this instance
+     */
+    type &operator=(type &&source) noexcept
+    {
+        ::std::unique_lock<::std::shared_mutex> guard1(subscribe_mutex);
+        ::std::unique_lock<::std::shared_mutex> guard2(source.subscribe_mutex);
+        _buckets.swap(source._buckets);
+        ::std::swap(next_id, source.next_id);
+        return *this;
+    }
+
+    /**
+     * @brief Default constructor
+     *
+     */
+    constexpr bucket_event() noexcept = default;
+
+    /**
+     * @brief Move constructor
+     *
+     * @param source Rvalue
+     */
+    bucket_event(type &&source)
+    {
+        ::std::unique_lock<::std::shared_mutex> guard(source.subscribe_mutex);
+        _buckets.swap(source._buckets);
+        next_id = source.next_id;
+    }
+
+    /// @brief Copy constructor (deleted)
+    bucket_event(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /// @brief Callbacks of any type
+    struct bucket_base
+    {
+        virtual ~bucket_base() = default;
+
+        /// @brief Call all callbacks in this bucket
+        virtual void dispatch(const Args &...args) = 0;
+
+        /// @brief Remove a callback, if found
+        /// @return true if found
+        virtual bool erase(::std::size_t id) = 0;
+
+        /// @brief Get the number of callbacks in this bucket
+        virtual ::std::size_t size() const noexcept = 0;
+
+        /// @brief Check the type of callbacks in this bucket
+        virtual bool holds(const ::std::type_info &info) const noexcept = 0;
+    };
+
+    /// @brief Callbacks of the same type
+    template <class F>
+    struct bucket : bucket_base
+    {
+        /// @brief Callable objects in subscription order
+        ::std::vector<F> callables{};
+        /// @brief Subscription ids (same order as callables)
+        ::std::vector<::std::size_t> ids{};
+
+        void dispatch(const Args &...args) override
+        {
+            for (auto &callable : callables)
+                callable(args...);
+        }
+
+        bool erase(::std::size_t id) override
+        {
+            for (::std::size_t i = 0; i < ids.size(); i++)
+                if (ids[i] == id)
+                {
+                    // Note: closure types are not assignable,
+                    // so std::vector::erase() is not available
+                    ::std::vector<F> kept;
+                    kept.reserve(callables.size());
+                    for (::std::size_t j = 0; j < callables.size(); j++)
+                        if (j != i)
+                            kept.emplace_back(::std::move(callables[j]));
+                    callables.swap(kept);
+                    ids.erase(ids.begin() + i);
+                    return true;
+                }
+            return false;
+        }
+
+        ::std::size_t size() const noexcept override
+        {
+            return callables.size();
+        }
+
+        bool holds(const ::std::type_info &info) const noexcept override
+        {
+            return (info == typeid(F));
+        }
+    };
+
+    /// @brief Buckets in order of first subscription
+    ::std::vector<::std::unique_ptr<bucket_base>> _buckets{};
+    /// @brief Next subscription id
+    ::std::size_t next_id{0};
+    /// @brief Mutex for thread-safe operations
+    mutable ::std::shared_mutex subscribe_mutex{};
+};
+
+//------------------------------------------------------------------------------
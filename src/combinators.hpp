@@ -0,0 +1,509 @@
+/**
+ * @file combinators.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Combine latest, zip and merge of events and observables
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "event.hpp"
+#include "observable.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Lock doing nothing
+ *
+ * @note Use it as the lock type of combinators
+ *       when all sources are dispatched in the same thread
+ */
+struct no_lock
+{
+    /// @brief Do nothing
+    constexpr void lock() noexcept {}
+    /// @brief Do nothing
+    constexpr void unlock() noexcept {}
+    /// @brief Do nothing
+    /// @return true Always
+    constexpr bool try_lock() noexcept { return true; }
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Subscription to the values of an event or an observable
+ *
+ * @note Sources are events having a single argument
+ *       or the on_change event of observables.
+ * @note Unsubscribes on destruction
+ *
+ * @tparam T Value type
+ */
+template <class T>
+class value_subscription
+{
+public:
+    /**
+     * @brief Subscribe to an event
+     *
+     * @tparam Callback Callback type
+     * @param source Event
+     * @param callback Takes a value
+     */
+    template <class Callback>
+    value_subscription(event<T> &source, Callback callback)
+        : _unsubscribe{link(source, ::std::move(callback))} {}
+
+    /**
+     * @brief Subscribe to an event
+     *
+     * @tparam Callback Callback type
+     * @param source Event
+     * @param callback Takes a value
+     */
+    template <class Callback>
+    value_subscription(event<const T &> &source, Callback callback)
+        : _unsubscribe{link(source, ::std::move(callback))} {}
+
+    /**
+     * @brief Subscribe to value changes of an observable
+     *
+     * @tparam Callback Callback type
+     * @param source Observable
+     * @param callback Takes a value
+     */
+    template <class Callback>
+    value_subscription(observable<T> &source, Callback callback)
+        : _unsubscribe{link(
+              source.on_change,
+              [callback = ::std::move(callback)](void *, const T &value) mutable
+              { callback(value); })} {}
+
+    /**
+     * @brief Move constructor
+     *
+     * @param source Instance to be moved (no longer subscribed)
+     */
+    value_subscription(value_subscription &&source) noexcept
+        : _unsubscribe{::std::exchange(source._unsubscribe, nullptr)} {}
+    /// @brief Copy constructor (deleted)
+    value_subscription(const value_subscription &) = delete;
+    /// @brief Move-assignment (deleted)
+    value_subscription &operator=(value_subscription &&) = delete;
+    /// @brief Copy-assignment (deleted)
+    value_subscription &operator=(const value_subscription &) = delete;
+
+    /**
+     * @brief Unsubscribe
+     *
+     */
+    ~value_subscription()
+    {
+        if (_unsubscribe)
+            _unsubscribe();
+    }
+
+private:
+    /**
+     * @brief Subscribe
+     *
+     * @tparam Source Event type
+     * @tparam Callback Callback type
+     * @param source Event
+     * @param callback Callback
+     * @return ::std::function<void()> Unsubscription
+     */
+    template <class Source, class Callback>
+    static ::std::function<void()> link(Source &source, Callback callback)
+    {
+        auto h = ::std::make_shared<typename Source::subscription_handler>(
+            source.subscribe(::std::move(callback)));
+        return [&source, h]()
+        { source.unsubscribe(*h); };
+    }
+
+    /// @brief Unsubscription
+    ::std::function<void()> _unsubscribe;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Dispatch the latest values of all sources when any of them changes
+ *
+ * @note Latest values are stored inline.
+ *       Nothing is dispatched until all sources have a value.
+ * @note The downstream event is dispatched with the lock held,
+ *       so its callbacks must not dispatch the sources
+ *       unless the lock is recursive.
+ *
+ * @tparam Lock Lock type: ::std::mutex, ::std::recursive_mutex
+ *              or no_lock (all sources dispatched in the same thread)
+ * @tparam Ts Value types
+ */
+template <class Lock, class... Ts>
+class combine_latest
+{
+public:
+    /// @brief This type
+    using type = combine_latest<Lock, Ts...>;
+    /// @brief Downstream event type
+    using event_type = event<const Ts &...>;
+
+    /**
+     * @brief Subscribe to all sources
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Sources Source types: events or observables
+     * @param downstream Downstream event
+     * @param sources Sources
+     */
+    template <class... Sources>
+        requires(sizeof...(Sources) == sizeof...(Ts))
+    explicit combine_latest(event_type &downstream, Sources &...sources)
+        : _downstream{downstream},
+          _links{link(::std::index_sequence_for<Ts...>{}, sources...)} {}
+
+    /**
+     * @brief Check if all sources have a value
+     *
+     * @return true if dispatching
+     * @return false otherwise
+     */
+    bool ready() const
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        return (_missing == 0);
+    }
+
+    /// @brief Copy constructor (deleted)
+    combine_latest(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Subscribe to all sources
+     *
+     * @tparam I Source indices
+     * @tparam Sources Source types
+     * @param sources Sources
+     * @return auto Subscriptions
+     */
+    template <::std::size_t... I, class... Sources>
+    ::std::tuple<value_subscription<Ts>...> link(
+        ::std::index_sequence<I...>,
+        Sources &...sources)
+    {
+        return {value_subscription<Ts>(
+            sources,
+            [this](const Ts &value)
+            { receive<I>(value); })...};
+    }
+
+    /**
+     * @brief Store a value and dispatch downstream
+     *
+     * @tparam I Source index
+     * @param value Value
+     */
+    template <::std::size_t I>
+    void receive(const ::std::tuple_element_t<I, ::std::tuple<Ts...>> &value)
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        auto &latest = ::std::get<I>(_latest);
+        if (latest)
+            *latest = value;
+        else
+        {
+            latest.emplace(value);
+            _missing--;
+        }
+        if (_missing == 0)
+            ::std::apply(
+                [this](const auto &...values)
+                { _downstream(*values...); },
+                _latest);
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Latest values
+    ::std::tuple<::std::optional<Ts>...> _latest{};
+    /// @brief Count of sources without a value
+    ::std::size_t _missing{sizeof...(Ts)};
+    /// @brief Lock
+    mutable Lock _lock{};
+    /// @brief Subscriptions (destroyed first)
+    ::std::tuple<value_subscription<Ts>...> _links;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Dispatch values of all sources in lockstep
+ *
+ * @note Values are buffered until all sources have a value,
+ *       then the oldest value of each source is dispatched.
+ * @note Buffers are bounded: the oldest value of a source
+ *       is dropped when its buffer is full.
+ * @note The downstream event is dispatched with the lock held,
+ *       so its callbacks must not dispatch the sources
+ *       unless the lock is recursive.
+ *
+ * @tparam Lock Lock type: ::std::mutex, ::std::recursive_mutex
+ *              or no_lock (all sources dispatched in the same thread)
+ * @tparam Ts Value types
+ */
+template <class Lock, class... Ts>
+class zip
+{
+public:
+    /// @brief This type
+    using type = zip<Lock, Ts...>;
+    /// @brief Downstream event type
+    using event_type = event<const Ts &...>;
+
+    /**
+     * @brief Subscribe to all sources
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Sources Source types: events or observables
+     * @param downstream Downstream event
+     * @param capacity Maximum count of buffered values per source
+     * @param sources Sources
+     */
+    template <class... Sources>
+        requires(sizeof...(Sources) == sizeof...(Ts))
+    zip(event_type &downstream, ::std::size_t capacity, Sources &...sources)
+        : _downstream{downstream},
+          _buffers{buffer<Ts>(::std::max<::std::size_t>(capacity, 1))...},
+          _links{link(::std::index_sequence_for<Ts...>{}, sources...)} {}
+
+    /**
+     * @brief Get the count of dropped values
+     *
+     * @return ::std::size_t Count of values dropped due to full buffers
+     *         since construction
+     */
+    ::std::size_t dropped() const
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        return _dropped;
+    }
+
+    /// @brief Copy constructor (deleted)
+    zip(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Bounded FIFO of values
+     *
+     * @note Preallocated
+     *
+     * @tparam T Value type
+     */
+    template <class T>
+    struct buffer
+    {
+        /// @brief Ring of slots
+        ::std::vector<::std::optional<T>> slots;
+        /// @brief Index of the oldest value
+        ::std::size_t head{0};
+        /// @brief Count of values
+        ::std::size_t count{0};
+
+        /**
+         * @brief Create a buffer
+         *
+         * @param capacity Count of slots
+         */
+        explicit buffer(::std::size_t capacity) : slots(capacity) {}
+
+        /**
+         * @brief Append a value
+         *
+         * @param value Value
+         * @return true if the oldest value was dropped
+         * @return false otherwise
+         */
+        bool push(const T &value)
+        {
+            bool full = (count == slots.size());
+            if (full)
+                pop();
+            auto &slot = slots[(head + count) % slots.size()];
+            if (slot)
+                *slot = value;
+            else
+                slot.emplace(value);
+            count++;
+            return full;
+        }
+
+        /**
+         * @brief Get the oldest value
+         *
+         * @return const T& Oldest value
+         */
+        const T &front() const noexcept
+        {
+            return *slots[head];
+        }
+
+        /**
+         * @brief Remove the oldest value
+         *
+         * @note The slot keeps its value, so it is reused without allocation
+         */
+        void pop() noexcept
+        {
+            head = (head + 1) % slots.size();
+            count--;
+        }
+    };
+
+    /**
+     * @brief Subscribe to all sources
+     *
+     * @tparam I Source indices
+     * @tparam Sources Source types
+     * @param sources Sources
+     * @return auto Subscriptions
+     */
+    template <::std::size_t... I, class... Sources>
+    ::std::tuple<value_subscription<Ts>...> link(
+        ::std::index_sequence<I...>,
+        Sources &...sources)
+    {
+        return {value_subscription<Ts>(
+            sources,
+            [this](const Ts &value)
+            { receive<I>(value); })...};
+    }
+
+    /**
+     * @brief Buffer a value and dispatch downstream
+     *
+     * @tparam I Source index
+     * @param value Value
+     */
+    template <::std::size_t I>
+    void receive(const ::std::tuple_element_t<I, ::std::tuple<Ts...>> &value)
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        if (::std::get<I>(_buffers).push(value))
+            _dropped++;
+        bool ready = ::std::apply(
+            [](const auto &...buffers)
+            { return (... && (buffers.count > 0)); },
+            _buffers);
+        if (ready)
+            ::std::apply(
+                [this](auto &...buffers)
+                {
+                    _downstream(buffers.front()...);
+                    (buffers.pop(), ...);
+                },
+                _buffers);
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Buffered values
+    ::std::tuple<buffer<Ts>...> _buffers;
+    /// @brief Count of dropped values
+    ::std::size_t _dropped{0};
+    /// @brief Lock
+    mutable Lock _lock{};
+    /// @brief Subscriptions (destroyed first)
+    ::std::tuple<value_subscription<Ts>...> _links;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Dispatch values of any source
+ *
+ * @note Dispatches to the downstream event are serialized by the lock
+ *
+ * @tparam Lock Lock type: ::std::mutex, ::std::recursive_mutex
+ *              or no_lock (all sources dispatched in the same thread)
+ * @tparam T Value type
+ */
+template <class Lock, class T>
+class merger
+{
+public:
+    /// @brief This type
+    using type = merger<Lock, T>;
+    /// @brief Downstream event type
+    using event_type = event<const T &>;
+
+    /**
+     * @brief Subscribe to all sources
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Sources Source types: events or observables
+     * @param downstream Downstream event
+     * @param sources Sources
+     */
+    template <class... Sources>
+    explicit merger(event_type &downstream, Sources &...sources)
+        : _downstream{downstream}
+    {
+        _links.reserve(sizeof...(Sources));
+        (_links.emplace_back(
+             sources,
+             [this](const T &value)
+             { receive(value); }),
+         ...);
+    }
+
+    /// @brief Copy constructor (deleted)
+    merger(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Dispatch downstream
+     *
+     * @param value Value
+     */
+    void receive(const T &value)
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        _downstream(value);
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Lock
+    Lock _lock{};
+    /// @brief Subscriptions (destroyed first)
+    ::std::vector<value_subscription<T>> _links{};
+};
+
+//------------------------------------------------------------------------------
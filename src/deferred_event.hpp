@@ -0,0 +1,272 @@
+/**
+ * @file deferred_event.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (deferred dispatch)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <concepts>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "event.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief How a deferred event collapses repeated event data
+ *
+ */
+enum class coalescing
+{
+    /// @brief Keep all event data
+    none,
+    /// @brief Discard event data equal to already queued event data
+    identical
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Publish-subscribe event dispatched at an explicit point
+ *
+ * @note Dispatching queues a copy of the event data.
+ *       Queued event data is delivered to all subscribed callbacks
+ *       in dispatch order when flush() is called.
+ * @note Repeated event data may be collapsed into one (coalescing):
+ *       identical event data, or event data having the same key.
+ * @note Subscribing and unsubscribing are thread-safe.
+ *       Dispatching and flushing must happen in the same thread.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class deferred_event : private event<Args...>
+{
+    /// @brief Subscriber storage and synchronous dispatch
+    using base = event<Args...>;
+
+public:
+    /// @brief This type
+    using type = deferred_event<Args...>;
+    /// @brief Callback type
+    using typename base::callback_type;
+    /// @brief Subscription handler for managing callback lifetimes
+    using typename base::subscription_handler;
+    /// @brief Copy of the event data
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+
+    using base::clear;
+    using base::emplace;
+    using base::subscribe;
+    using base::subscribed;
+    using base::unsubscribe;
+
+    /**
+     * @brief Subscribe forever
+     *
+     * @warning @p callback must exceed the lifetime of this instance
+     *
+     * @param callback Callback function to be called on flush
+     * @return type& This instance
+     */
+    type &operator+=(const callback_type &callback) noexcept
+    {
+        subscribe(callback);
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     *
+     * @param h Subscription handler returned by subscribe()
+     * @return type& This instance
+     */
+    type &operator-=(subscription_handler &h) noexcept
+    {
+        unsubscribe(h);
+        return *this;
+    }
+
+    /**
+     * @brief Queue event data for the next flush
+     *
+     * @note No callback is called
+     *
+     * @param args Event data
+     */
+    void operator()(const Args &...args)
+    {
+        if (_hash)
+        {
+            ::std::size_t hash = _hash(args...);
+            auto [first, last] = _index.equal_range(hash);
+            for (auto it = first; it != last; ++it)
+                if (_same_key(_queue[it->second], args...))
+                {
+                    // Latest event data in place of the first one
+                    _queue[it->second] = payload_type(args...);
+                    _coalesced++;
+                    return;
+                }
+            _index.emplace(hash, _queue.size());
+        }
+        else if constexpr (::std::equality_comparable<payload_type>)
+            if (_identical)
+                for (const auto &item : _queue)
+                    if (item == ::std::forward_as_tuple(args...))
+                    {
+                        _coalesced++;
+                        return;
+                    }
+        _queue.emplace_back(args...);
+    }
+
+    /**
+     * @brief Deliver all queued event data to all subscribed callbacks
+     *
+     * @note Event data dispatched by the callbacks is queued
+     *       for the next flush
+     * @note No effect if called from a callback
+     *
+     * @return ::std::size_t Count of delivered event data
+     */
+    ::std::size_t flush()
+    {
+        if (_flushing_now)
+            return 0;
+        // Note: both vectors keep their capacity,
+        // so flushing does not allocate in the steady state
+        _flushing.swap(_queue);
+        _index.clear();
+        _flushing_now = true;
+        try
+        {
+            for (const auto &item : _flushing)
+                ::std::apply(
+                    [this](const auto &...data)
+                    { base::operator()(data...); },
+                    item);
+        }
+        catch (...)
+        {
+            _flushing.clear();
+            _flushing_now = false;
+            throw;
+        }
+        ::std::size_t count = _flushing.size();
+        _flushing.clear();
+        _flushing_now = false;
+        return count;
+    }
+
+    /**
+     * @brief Discard all queued event data
+     *
+     */
+    void discard() noexcept
+    {
+        _queue.clear();
+        _index.clear();
+    }
+
+    /**
+     * @brief Get the count of queued event data
+     *
+     * @return ::std::size_t Count of event data to be delivered on flush
+     */
+    ::std::size_t pending() const noexcept
+    {
+        return _queue.size();
+    }
+
+    /**
+     * @brief Get the count of collapsed event data
+     *
+     * @return ::std::size_t Count of dispatches not queued due to coalescing
+     *         since construction
+     */
+    ::std::size_t coalesced() const noexcept
+    {
+        return _coalesced;
+    }
+
+    /**
+     * @brief Create a deferred event without coalescing
+     *
+     */
+    deferred_event() noexcept = default;
+
+    /**
+     * @brief Create a deferred event
+     *
+     * @note Coalescing of identical event data takes linear time
+     *       in the count of queued event data
+     *
+     * @param mode Coalescing mode
+     */
+    explicit deferred_event(coalescing mode) noexcept
+        requires ::std::equality_comparable<payload_type>
+        : _identical{mode == coalescing::identical} {}
+
+    /**
+     * @brief Create a deferred event coalescing by key
+     *
+     * @note Event data having the same key as queued event data
+     *       replaces it, keeping its place in the queue
+     *
+     * @tparam KeyFn Key extractor type
+     * @param key Key extractor: takes the event data and returns a hashable key
+     */
+    template <class KeyFn>
+    explicit deferred_event(KeyFn key)
+    {
+        using key_type =
+            ::std::decay_t<::std::invoke_result_t<KeyFn, const Args &...>>;
+        _hash = [key](const Args &...args) -> ::std::size_t
+        {
+            return ::std::hash<key_type>{}(::std::invoke(key, args...));
+        };
+        _same_key = [key](const payload_type &queued, const Args &...args) -> bool
+        {
+            return (::std::apply(key, queued) == ::std::invoke(key, args...));
+        };
+    }
+
+    /// @brief Copy constructor (deleted)
+    deferred_event(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /// @brief Queued event data
+    ::std::vector<payload_type> _queue{};
+    /// @brief Event data being delivered
+    ::std::vector<payload_type> _flushing{};
+    /// @brief Positions in the queue by hash of the key (if coalescing by key)
+    ::std::unordered_multimap<::std::size_t, ::std::size_t> _index{};
+    /// @brief Hash of the key of some event data (if coalescing by key)
+    ::std::function<::std::size_t(const Args &...)> _hash{};
+    /// @brief Key comparison (if coalescing by key)
+    ::std::function<bool(const payload_type &, const Args &...)> _same_key{};
+    /// @brief True if coalescing identical event data
+    bool _identical{false};
+    /// @brief True while flushing
+    bool _flushing_now{false};
+    /// @brief Count of collapsed event data
+    ::std::size_t _coalesced{0};
+};
+
+//------------------------------------------------------------------------------
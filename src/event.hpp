@@ -13,8 +13,20 @@
 
 //------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
-#include <deque>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include "executor.hpp"
 #include <mutex>
 #include <shared_mutex>
 
@@ -24,12 +36,25 @@
  * @brief Publish-subscribe event
  *
  * @note Thread-safe
+ * @note Subscriber storage is allocated from a polymorphic memory resource
+ *       (the default resource unless given at construction).
+ * @note Copies share the list of subscribers until
+ *       one of them subscribes or unsubscribes (copy-on-write).
+ * @note Slow callbacks may be moved to an executor automatically.
+ *       See set_latency_budget().
  *
  * @tparam Args Callback argument types
  */
 template <class... Args>
 class event
 {
+    struct subscription_entry;
+    /// @brief Subscription list type
+    /// @note Sorted by id, since ids are taken with the mutex locked
+    using list_type = ::std::pmr::vector<subscription_entry>;
+    /// @brief Copy of the event data for deferred calls
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+
 public:
     /// @brief This type
     using type = event<Args...>;
@@ -97,13 +122,60 @@ public:
             return subscription_handler();
 
         ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
-        _subscriptions.push_back(
+        ::std::size_t id = next_id.fetch_add(1, ::std::memory_order_relaxed);
+        writable_list().push_back(
             {
                 .callback = callback,
-                .id = next_id,
+                .id = id,
+                .monitor = new_monitor(),
             });
 
-        return subscription_handler(this, next_id++);
+        return subscription_handler(this, id);
+    }
+
+    /**
+     * @brief Subscribe a callback function to be executed by an executor
+     *
+     * @note On dispatch, a single copy of the event data is posted
+     *       to each executor, shared by all the callbacks subscribed to it.
+     * @note Event data must be copyable.
+     * @note No further calls to @p callback after unsubscription,
+     *       as long as unsubscribe() is called by the executor's thread.
+     * @warning Each dispatch posts a separate task to @p target.
+     *          If @p target runs tasks in several threads (thread_pool),
+     *          calls to @p callback may overlap and be reordered,
+     *          so @p callback must be thread-safe.
+     *
+     * @param callback Callback function to be called on event dispatch
+     * @param target Executor where @p callback is to be called
+     * @return subscription_handler Handler required to unsubscribe
+     */
+    subscription_handler subscribe(
+        const callback_type &callback,
+        executor &target) noexcept
+    {
+        static_assert(
+            deferrable,
+            "Event data must be copyable and not bound to non-const references");
+        if (!callback)
+            return subscription_handler();
+
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        ::std::size_t id = next_id.fetch_add(1, ::std::memory_order_relaxed);
+        list_type &list = writable_list();
+        list.push_back(
+            {
+                .callback = callback,
+                .id = id,
+                .target = &target,
+                .active = ::std::allocate_shared<::std::atomic<bool>>(
+                    ::std::pmr::polymorphic_allocator<::std::atomic<bool>>(_resource),
+                    true),
+            });
+        _deferred++;
+        elect_leaders(list);
+
+        return subscription_handler(this, id);
     }
 
     /**
@@ -126,6 +198,52 @@ public:
         return subscribe(callback);
     }
 
+    /**
+     * @brief Subscribe a callable object stored in this event's memory resource
+     *
+     * @note The callable object is allocated from get_memory_resource()
+     *       and destroyed on unsubscription, so callback state is laid out
+     *       contiguously when using an arena.
+     * @note Copies of this event share the same callable object.
+     * @note On move-assignment to an event having another memory resource,
+     *       the callable object is copied to that resource,
+     *       unless it is not copy-constructible.
+     *
+     * @tparam F Callable object type
+     * @param callable Callable object to be called on event dispatch
+     * @return subscription_handler Handler required to unsubscribe
+     */
+    template <class F>
+    subscription_handler emplace(F &&callable) noexcept
+    {
+        using object_type = ::std::decay_t<F>;
+        ::std::pmr::polymorphic_allocator<object_type> allocator(_resource);
+        auto storage = ::std::allocate_shared<object_type>(
+            allocator,
+            ::std::forward<F>(callable));
+
+        // Note: a pointer-sized capture is stored
+        // inside std::function without allocation
+        object_type *target = storage.get();
+        callback_type callback = [target](Args... args)
+        {
+            (*target)(args...);
+        };
+
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        ::std::size_t id = next_id.fetch_add(1, ::std::memory_order_relaxed);
+        writable_list().push_back(
+            {
+                .callback = ::std::move(callback),
+                .id = id,
+                .storage = ::std::move(storage),
+                .monitor = new_monitor(),
+                .relocate = relocator<object_type>(),
+            });
+
+        return subscription_handler(this, id);
+    }
+
     /**
      * @brief Subscribe forever
      *
@@ -155,14 +273,24 @@ public:
             return;
 
         ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
-        for (auto entry = _subscriptions.begin();
-             entry != _subscriptions.end();
-             ++entry)
-            if (entry->id == h.id)
-            {
-                _subscriptions.erase(entry);
-                break;
-            }
+        if (_subscriptions)
+            for (::std::size_t index = 0; index < _subscriptions->size(); index++)
+                if ((*_subscriptions)[index].id == h.id)
+                {
+                    list_type &list = writable_list();
+                    if (list[index].monitor)
+                        list[index].monitor->cancel();
+                    if (list[index].target)
+                    {
+                        list[index].active->store(false, ::std::memory_order_release);
+                        _deferred--;
+                    }
+                    list.erase(list.begin() + index);
+                    if (_deferred)
+                        // Note: the following entries have been shifted
+                        elect_leaders(list);
+                    break;
+                }
         h.owner = nullptr;
     }
 
@@ -189,31 +317,143 @@ public:
     void clear() noexcept
     {
         ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
-        _subscriptions.clear();
+        deactivate();
+        _subscriptions.reset();
     }
 
     /**
      * @brief Dispatch event to all subscribed callbacks
      *
+     * @note Callbacks subscribed to an executor are posted, not called
+     *
      * @param args Event data
      */
     void operator()(const Args &...args)
     {
-        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
-        for (const auto &entry : _subscriptions)
-            entry.callback(args...);
+        dispatch(args...);
     }
 
     /**
      * @brief Dispatch event to all subscribed callbacks (const)
      *
+     * @note Callbacks subscribed to an executor are posted, not called
+     *
      * @param args Event data
      */
     void operator()(const Args &...args) const
     {
-        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
-        for (const auto &entry : _subscriptions)
-            entry.callback(args...);
+        dispatch(args...);
+    }
+
+    /**
+     * @brief Resumable dispatch
+     *
+     * @note Calls subscribed callbacks a few at a time, within a time budget,
+     *       so heavy dispatching can be spread across several frames
+     *       of a loop.
+     * @note Each callback subscribed at the time of begin_dispatch()
+     *       is called exactly once, unless unsubscribed before its turn.
+     *       Callbacks subscribed later are not called.
+     * @warning The event must exceed the lifetime of this cursor
+     */
+    class dispatch_cursor
+    {
+        friend class event<Args...>;
+        /// @brief Dispatching event
+        const type *owner{nullptr};
+        /// @brief Subscription entries at the time of begin_dispatch()
+        ::std::shared_ptr<list_type> list{};
+        /// @brief Copy of the event data
+        ::std::shared_ptr<const payload_type> payload{};
+        /// @brief Index of the next entry to call
+        ::std::size_t index{0};
+
+    public:
+        /**
+         * @brief Call pending callbacks until the time budget expires
+         *
+         * @note At least one pending callback is called, if any,
+         *       even if it takes longer than @p budget
+         *
+         * @param budget Time budget
+         * @return true if all callbacks have been called
+         * @return false if there are pending callbacks
+         */
+        bool resume(::std::chrono::nanoseconds budget)
+        {
+            if (done())
+                return true;
+            auto deadline = ::std::chrono::steady_clock::now() + budget;
+            ::std::shared_lock<::std::shared_mutex> guard(owner->subscribe_mutex);
+            do
+            {
+                // Note: the index moves first, so a callback that throws
+                // is not called again
+                ::std::size_t current = index++;
+                owner->resume_entry(list, current, payload);
+            } while ((index < list->size()) &&
+                     (::std::chrono::steady_clock::now() < deadline));
+            return done();
+        }
+
+        /**
+         * @brief Check if all callbacks have been called
+         *
+         * @return true if finished
+         * @return false if there are pending callbacks
+         */
+        bool done() const noexcept
+        {
+            return !list || (index >= list->size());
+        }
+
+        /**
+         * @brief Get the number of pending callbacks
+         *
+         * @return ::std::size_t Count of subscriptions not visited yet
+         */
+        ::std::size_t pending() const noexcept
+        {
+            return done() ? 0 : (list->size() - index);
+        }
+
+        /// @brief Default constructor
+        dispatch_cursor() noexcept = default;
+        /// @brief Move constructor (default)
+        dispatch_cursor(dispatch_cursor &&) noexcept = default;
+        /// @brief Copy constructor (deleted)
+        dispatch_cursor(const dispatch_cursor &) = delete;
+        /// @brief Move-assignment (default)
+        dispatch_cursor &operator=(dispatch_cursor &&) noexcept = default;
+        /// @brief Copy-assignment (deleted)
+        dispatch_cursor &operator=(const dispatch_cursor &) = delete;
+    };
+
+    /**
+     * @brief Start a resumable dispatch
+     *
+     * @note No callback is called until dispatch_cursor::resume()
+     * @note Event data must be copyable.
+     *
+     * @param args Event data
+     * @return dispatch_cursor Cursor
+     */
+    dispatch_cursor begin_dispatch(const Args &...args) const
+    {
+        static_assert(
+            deferrable,
+            "Event data must be copyable and not bound to non-const references");
+        dispatch_cursor cursor;
+        cursor.owner = this;
+        {
+            ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+            cursor.list = _subscriptions;
+        }
+        if (cursor.list)
+            cursor.payload = ::std::allocate_shared<const payload_type>(
+                ::std::pmr::polymorphic_allocator<payload_type>(&payload_pool()),
+                args...);
+        return cursor;
     }
 
     /**
@@ -223,12 +463,151 @@ public:
      */
     ::std::size_t subscribed()
     {
-        return _subscriptions.size();
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        return _subscriptions ? _subscriptions->size() : 0;
+    }
+
+    /**
+     * @brief Move slow callbacks to an executor automatically
+     *
+     * @note The duration of each call is measured.
+     *       Callbacks taking longer than @p budget on average are *demoted*:
+     *       they are posted to @p fallback instead of being called on dispatch.
+     *       Demoted callbacks are called again on dispatch as soon as
+     *       they take less than half the @p budget on average.
+     * @note Callbacks subscribed to an executor are not affected.
+     * @note Calls to a demoted callback are executed one at a time
+     *       in dispatch order, even if @p fallback runs tasks
+     *       in several threads.
+     * @note May be called again to change the budget or the executor.
+     *       Measurements and pending calls are kept, so calls to
+     *       a demoted callback still never overlap nor get reordered.
+     * @note Event data must be copyable.
+     * @warning @p fallback must exceed the lifetime of this instance,
+     *          and so must the executors given before
+     *
+     * @param budget Maximum average duration of a call.
+     *               Zero means no measurements and no demotions.
+     *               Pending calls to demoted callbacks are still executed.
+     * @param fallback Executor where demoted callbacks are called
+     */
+    void set_latency_budget(
+        ::std::chrono::nanoseconds budget,
+        executor &fallback)
+    {
+        static_assert(
+            deferrable,
+            "Event data must be copyable and not bound to non-const references");
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        _budget = (budget.count() > 0) ? budget : ::std::chrono::nanoseconds::zero();
+        _fallback = &fallback;
+        if (!_subscriptions)
+            return;
+        for (auto &entry : writable_list())
+            if (entry.monitor)
+                entry.monitor->budget.store(
+                    _budget.count(),
+                    ::std::memory_order_relaxed);
+            else if (!entry.target)
+                entry.monitor = new_monitor();
+    }
+
+    /**
+     * @brief Check if a callback is demoted
+     *
+     * @param h Subscription handler returned by subscribe()
+     * @return true if the callback is currently called by the executor
+     *         given to set_latency_budget()
+     * @return false otherwise
+     */
+    bool is_demoted(const subscription_handler &h) const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        if ((h.owner != this) || !_subscriptions)
+            return false;
+        for (const auto &entry : *_subscriptions)
+            if (entry.id == h.id)
+                return entry.monitor && demoted(*entry.monitor);
+        return false;
+    }
+
+    /**
+     * @brief Get the number of demoted callbacks
+     *
+     * @return ::std::size_t Count of callbacks currently called by
+     *         the executor given to set_latency_budget()
+     */
+    ::std::size_t demoted() const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        ::std::size_t count = 0;
+        if (_subscriptions)
+            for (const auto &entry : *_subscriptions)
+                if (entry.monitor && demoted(*entry.monitor))
+                    count++;
+        return count;
+    }
+
+    /**
+     * @brief Reserve storage for a number of subscriptions
+     *
+     * @note Subscribing up to @p count callbacks will not
+     *       allocate storage for the subscription list afterwards.
+     *
+     * @param count Expected count of subscribed callbacks
+     */
+    void reserve(::std::size_t count)
+    {
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        writable_list().reserve(count);
+    }
+
+    /**
+     * @brief Release unused storage for subscriptions
+     *
+     * @note Non-binding request
+     */
+    void shrink_to_fit()
+    {
+        ::std::unique_lock<::std::shared_mutex> guard(subscribe_mutex);
+        if (!_subscriptions)
+            return;
+        if (_subscriptions->empty())
+            _subscriptions.reset();
+        else
+            writable_list().shrink_to_fit();
+    }
+
+    /**
+     * @brief Get the number of subscriptions that fit in allocated storage
+     *
+     * @return ::std::size_t Reserved count of subscriptions
+     */
+    ::std::size_t capacity() const noexcept
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        return _subscriptions ? _subscriptions->capacity() : 0;
+    }
+
+    /**
+     * @brief Get the memory resource used for subscriber storage
+     *
+     * @return ::std::pmr::memory_resource* Memory resource
+     */
+    ::std::pmr::memory_resource *get_memory_resource() const noexcept
+    {
+        return _resource;
     }
 
     /**
      * @brief Move-assignment
      *
+     * @note Subscriptions are exchanged.
+     *       If both instances have different memory resources,
+     *       subscriptions are copied to the memory resource of their new owner
+     *       and pending calls to callbacks subscribed to an executor
+     *       are cancelled.
+     *
      * @param source Rvalue
      * @return type& Reference to this instance
      */
@@ -237,12 +616,24 @@ public:
         ::std::unique_lock<::std::shared_mutex> guard1(subscribe_mutex);
         ::std::unique_lock<::std::shared_mutex> guard2(source.subscribe_mutex);
         _subscriptions.swap(source._subscriptions);
+        ::std::swap(_deferred, source._deferred);
+        ::std::swap(_budget, source._budget);
+        ::std::swap(_fallback, source._fallback);
+        if (!_resource->is_equal(*source._resource))
+        {
+            // Storage can not be exchanged between
+            // different memory resources
+            relocate();
+            source.relocate();
+        }
         return *this;
     }
 
     /**
      * @brief Copy-assignment
      *
+     * @note Constant time: the list of subscribers is shared
+     *
      * @param source Instance to be copied
      * @return type& Reference to this instance
      */
@@ -250,7 +641,8 @@ public:
     {
         ::std::unique_lock<::std::shared_mutex> guard1(subscribe_mutex);
         ::std::shared_lock<::std::shared_mutex> guard2(source.subscribe_mutex);
-        _subscriptions = source._subscriptions;
+        deactivate();
+        copy_from(source);
         return *this;
     }
 
@@ -260,15 +652,30 @@ public:
      */
     constexpr event() noexcept = default;
 
+    /**
+     * @brief Construct an event allocating from a given memory resource
+     *
+     * @warning @p resource must exceed the lifetime of this instance
+     *          and any copy of it
+     *
+     * @param resource Memory resource for subscriber storage
+     */
+    explicit event(::std::pmr::memory_resource *resource) noexcept
+        : _resource{resource} {}
+
     /**
      * @brief Copy constructor
      *
+     * @note The copy allocates from the same memory resource as @p source
+     * @note Constant time: the list of subscribers is shared
+     *
      * @param source Instance to be copied
      */
     event(const type &source)
+        : _resource{source._resource}
     {
         ::std::shared_lock<::std::shared_mutex> guard2(source.subscribe_mutex);
-        _subscriptions = source._subscriptions;
+        copy_from(source);
     }
 
     /**
@@ -277,12 +684,137 @@ public:
      * @param source Rvalue
      */
     event(type &&source)
+        : _resource{source._resource}
     {
         ::std::unique_lock<::std::shared_mutex> guard(source.subscribe_mutex);
         _subscriptions.swap(source._subscriptions);
+        ::std::swap(_deferred, source._deferred);
+        ::std::swap(_budget, source._budget);
+        ::std::swap(_fallback, source._fallback);
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * @note Pending calls to callbacks subscribed to an executor
+     *       are cancelled
+     */
+    ~event() noexcept
+    {
+        deactivate();
     }
 
 private:
+    /// @brief Pending call to a demoted callback
+    struct demoted_call
+    {
+        /// @brief Subscription entries at the time of dispatch
+        ::std::shared_ptr<list_type> list{};
+        /// @brief Index of the entry in list
+        ::std::size_t index{0};
+        /// @brief Copy of the event data
+        ::std::shared_ptr<const payload_type> payload{};
+    };
+
+    /// @brief Call duration measurements of a callback
+    struct latency_monitor
+    {
+        /// @brief Bit of state set while demoted
+        static constexpr ::std::size_t demoted_bit =
+            ~(::std::numeric_limits<::std::size_t>::max() >> 1);
+
+        /// @brief Count of pending calls in the executor,
+        ///        plus demoted_bit while demoted
+        ::std::atomic<::std::size_t> state{0};
+        /// @brief Average call duration in nanoseconds
+        ::std::atomic<::std::int64_t> average{0};
+        /// @brief Latency budget in nanoseconds (zero means none)
+        ::std::atomic<::std::int64_t> budget{0};
+        /// @brief Cleared on unsubscription
+        ::std::atomic<bool> active{true};
+        /// @brief Pending calls in the executor, in dispatch order.
+        ///        The first one may be running.
+        ::std::vector<demoted_call> calls{};
+        /// @brief Index of the first pending call in calls
+        ::std::size_t first{0};
+        /// @brief True while a task executes the pending calls
+        bool draining{false};
+        /// @brief Mutex for calls
+        ::std::mutex strand_mutex{};
+
+        /// @brief Update the average call duration
+        /// @param duration Duration of the last call
+        /// @return ::std::int64_t New average in nanoseconds
+        ::std::int64_t record(::std::chrono::nanoseconds duration) noexcept
+        {
+            // Note: concurrent updates may be lost, which is harmless
+            ::std::int64_t value = average.load(::std::memory_order_relaxed);
+            value += (duration.count() - value) / 4;
+            average.store(value, ::std::memory_order_relaxed);
+            return value;
+        }
+
+        /// @brief Queue a call
+        /// @param call Pending call
+        /// @return true if a task must be posted to execute the pending calls
+        bool push(demoted_call &&call)
+        {
+            ::std::lock_guard<::std::mutex> guard(strand_mutex);
+            calls.push_back(::std::move(call));
+            if (draining)
+                return false;
+            draining = true;
+            return true;
+        }
+
+        /// @brief Get the first pending call
+        /// @note The task executing the pending calls finishes
+        ///       when there are none
+        /// @param call Copy of the first pending call
+        /// @return true if there is a pending call
+        bool front(demoted_call &call)
+        {
+            ::std::lock_guard<::std::mutex> guard(strand_mutex);
+            if (first == calls.size())
+            {
+                draining = false;
+                return false;
+            }
+            call = calls[first];
+            return true;
+        }
+
+        /// @brief Discard the first pending call
+        /// @note Its caller keeps a copy
+        void pop_front() noexcept
+        {
+            ::std::lock_guard<::std::mutex> guard(strand_mutex);
+            calls[first++] = {};
+            if (first == calls.size())
+            {
+                calls.clear();
+                first = 0;
+            }
+            else if (first * 2 >= calls.size())
+            {
+                calls.erase(calls.begin(), calls.begin() + first);
+                first = 0;
+            }
+        }
+
+        /// @brief Stop further calls
+        /// @note The running call (if any) is not affected.
+        ///       The caller keeps this monitor alive, so discarding
+        ///       the other calls does not destroy it.
+        void cancel() noexcept
+        {
+            active.store(false, ::std::memory_order_release);
+            ::std::lock_guard<::std::mutex> guard(strand_mutex);
+            if (calls.size() > first + 1)
+                calls.erase(calls.begin() + first + 1, calls.end());
+        }
+    };
+
     /// @brief Subscription entry
     struct subscription_entry
     {
@@ -290,12 +822,542 @@ private:
         callback_type callback;
         /// @brief Subscription id
         ::std::size_t id;
+        /// @brief Callable object owned by this entry (if any)
+        ::std::shared_ptr<void> storage{};
+        /// @brief Executor where the callback is called (if any)
+        executor *target{nullptr};
+        /// @brief Cleared on unsubscription (executor only)
+        ::std::shared_ptr<::std::atomic<bool>> active{};
+        /// @brief First entry subscribed to the same executor
+        bool leader{false};
+        /// @brief Index of the next entry subscribed to the same executor
+        ::std::size_t next{no_entry};
+        /// @brief Call duration measurements (if there is a latency budget)
+        ::std::shared_ptr<latency_monitor> monitor{};
+        /// @brief Copies the callable object in storage to another
+        ///        memory resource (if any)
+        void (*relocate)(subscription_entry &, ::std::pmr::memory_resource *){nullptr};
     };
 
-    /// @brief List of subscription entries
-    ::std::deque<subscription_entry> _subscriptions{};
-    /// @brief Next subscription id
-    ::std::size_t next_id{0};
+
+    /// @brief Index of no subscription entry
+    static constexpr ::std::size_t no_entry =
+        ::std::numeric_limits<::std::size_t>::max();
+
+    /// @brief True if event data can be copied for deferred calls
+    static constexpr bool deferrable =
+        (... && (::std::is_copy_constructible_v<::std::decay_t<Args>> &&
+                 !(::std::is_lvalue_reference_v<Args> &&
+                   !::std::is_const_v<::std::remove_reference_t<Args>>)));
+
+
+    /**
+     * @brief Get the list of subscription entries for writing
+     *
+     * @note Must be called with the mutex locked for writing
+     * @note The list is copied if shared with another instance
+     *
+     * @return list_type& List not shared with any other instance
+     */
+    list_type &writable_list()
+    {
+        ::std::pmr::polymorphic_allocator<list_type> allocator(_resource);
+        if (!_subscriptions)
+            _subscriptions = ::std::allocate_shared<list_type>(allocator);
+        else if (_subscriptions.use_count() > 1)
+            _subscriptions =
+                ::std::allocate_shared<list_type>(allocator, *_subscriptions);
+        else
+            // Synchronize with the release of the last sharing instance
+            ::std::atomic_thread_fence(::std::memory_order_acquire);
+        return *_subscriptions;
+    }
+
+    /**
+     * @brief Elect the first entry subscribed to each executor
+     *        and link the entries subscribed to the same executor
+     *
+     * @note The leader posts the event data on behalf of all
+     *       the entries subscribed to the same executor,
+     *       which are delivered following the links
+     * @note Linear time
+     * @note Memory is taken from the stack, or from the memory resource
+     *       of @p list if there are many executors
+     *
+     * @param list List of subscription entries
+     */
+    static void elect_leaders(list_type &list)
+    {
+        ::std::byte buffer[1024];
+        ::std::pmr::monotonic_buffer_resource arena(
+            buffer, sizeof(buffer), list.get_allocator().resource());
+        // Last entry subscribed to each executor
+        ::std::pmr::unordered_map<executor *, ::std::size_t> last(&arena);
+        for (::std::size_t index = 0; index < list.size(); index++)
+        {
+            auto &entry = list[index];
+            entry.leader = false;
+            entry.next = no_entry;
+            if (!entry.target)
+                continue;
+            auto [found, inserted] = last.try_emplace(entry.target, index);
+            if (inserted)
+                entry.leader = true;
+            else
+            {
+                list[found->second].next = index;
+                found->second = index;
+            }
+        }
+    }
+
+    /**
+     * @brief Stop pending deferred calls to all subscribed callbacks
+     *
+     * @note Must be called with the mutex locked for writing
+     *       (or not shared at all)
+     */
+    void deactivate() noexcept
+    {
+        if ((_deferred || _fallback) && _subscriptions)
+            deactivate(*_subscriptions);
+    }
+
+    /**
+     * @brief Stop pending deferred calls to the callbacks in a list
+     *
+     * @param list List of subscription entries
+     */
+    static void deactivate(const list_type &list) noexcept
+    {
+        for (const auto &entry : list)
+        {
+            if (entry.active)
+                entry.active->store(false, ::std::memory_order_release);
+            if (entry.monitor)
+                entry.monitor->cancel();
+        }
+    }
+
+    /**
+     * @brief Replace the state of deferred calls in a copied list
+     *
+     * @note Must be called with the mutex locked for writing
+     *
+     * @param list Copy of a list of subscription entries
+     */
+    void renew(list_type &list)
+    {
+        for (auto &entry : list)
+        {
+            if (entry.active)
+                entry.active = ::std::allocate_shared<::std::atomic<bool>>(
+                    ::std::pmr::polymorphic_allocator<::std::atomic<bool>>(_resource),
+                    true);
+            if (entry.monitor)
+                entry.monitor = new_monitor();
+        }
+    }
+
+    /**
+     * @brief Copy the list of subscription entries to this instance's
+     *        memory resource
+     *
+     * @note Must be called with the mutex locked for writing
+     * @note Pending deferred calls to the original entries are cancelled
+     */
+    void relocate()
+    {
+        if (!_subscriptions)
+            return;
+        auto original = ::std::move(_subscriptions);
+        _subscriptions = ::std::allocate_shared<list_type>(
+            ::std::pmr::polymorphic_allocator<list_type>(_resource),
+            *original);
+        renew(*_subscriptions);
+        for (auto &entry : *_subscriptions)
+            if (entry.relocate)
+                entry.relocate(entry, _resource);
+        deactivate(*original);
+    }
+
+    /**
+     * @brief Get the function that copies a stored callable object
+     *        to another memory resource
+     *
+     * @tparam F Callable object type
+     * @return Function, or null if @p F is not copy-constructible
+     */
+    template <class F>
+    static constexpr auto relocator() noexcept
+        -> void (*)(subscription_entry &, ::std::pmr::memory_resource *)
+    {
+        if constexpr (::std::is_copy_constructible_v<F>)
+            return [](subscription_entry &entry, ::std::pmr::memory_resource *resource)
+            {
+                auto storage = ::std::allocate_shared<F>(
+                    ::std::pmr::polymorphic_allocator<F>(resource),
+                    *static_cast<const F *>(entry.storage.get()));
+                F *target = storage.get();
+                entry.callback = [target](Args... args)
+                {
+                    (*target)(args...);
+                };
+                entry.storage = ::std::move(storage);
+            };
+        else
+            return nullptr;
+    }
+
+    /**
+     * @brief Create call duration measurements for a new subscription
+     *
+     * @note Must be called with the mutex locked for writing
+     *
+     * @return ::std::shared_ptr<latency_monitor> Measurements,
+     *         or null if there is no latency budget
+     */
+    ::std::shared_ptr<latency_monitor> new_monitor()
+    {
+        if (!_budget.count())
+            return nullptr;
+        auto monitor = ::std::allocate_shared<latency_monitor>(
+            ::std::pmr::polymorphic_allocator<latency_monitor>(_resource));
+        monitor->budget.store(_budget.count(), ::std::memory_order_relaxed);
+        return monitor;
+    }
+
+    /**
+     * @brief Check if a callback is demoted
+     *
+     * @param monitor Measurements of the callback
+     * @return true if demoted
+     * @return false otherwise
+     */
+    static bool demoted(const latency_monitor &monitor) noexcept
+    {
+        return (monitor.state.load(::std::memory_order_acquire) &
+                latency_monitor::demoted_bit) != 0;
+    }
+
+    /**
+     * @brief Copy subscriptions from another instance
+     *
+     * @note Must be called with the mutex of @p source locked
+     * @note The list of subscribers is shared unless there are
+     *       subscriptions to executors or a latency budget
+     *       (or there was one), which are not shareable
+     *
+     * @param source Instance to be copied
+     */
+    void copy_from(const type &source)
+    {
+        _deferred = source._deferred;
+        _budget = source._budget;
+        _fallback = source._fallback;
+        if ((!_deferred && !_fallback) || !source._subscriptions)
+        {
+            _subscriptions = source._subscriptions;
+            return;
+        }
+        _subscriptions = ::std::allocate_shared<list_type>(
+            ::std::pmr::polymorphic_allocator<list_type>(_resource),
+            *source._subscriptions);
+        renew(*_subscriptions);
+    }
+
+    /**
+     * @brief Pool of memory for copies of the event data
+     *
+     * @note Copies of the event data are shared by all executors
+     *       and returned to this pool by the last one to finish
+     *
+     * @return ::std::pmr::synchronized_pool_resource& Pool (thread-safe)
+     */
+    static ::std::pmr::synchronized_pool_resource &payload_pool()
+    {
+        // Note: never destroyed, since executors may still release
+        // copies of the event data during static destruction
+        static auto *pool = new ::std::pmr::synchronized_pool_resource();
+        return *pool;
+    }
+
+    /**
+     * @brief Call or post all subscribed callbacks
+     *
+     * @param args Event data
+     */
+    void dispatch(const Args &...args) const
+    {
+        ::std::shared_lock<::std::shared_mutex> guard(subscribe_mutex);
+        if (!_subscriptions)
+            return;
+        if constexpr (deferrable)
+        {
+            ::std::shared_ptr<const payload_type> payload{};
+            auto share_payload = [&payload, &args...]()
+            {
+                if (!payload)
+                    payload = ::std::allocate_shared<const payload_type>(
+                        ::std::pmr::polymorphic_allocator<payload_type>(
+                            &payload_pool()),
+                        args...);
+            };
+            const list_type &list = *_subscriptions;
+            for (::std::size_t index = 0; index < list.size(); index++)
+            {
+                const auto &entry = list[index];
+                if (!entry.target)
+                {
+                    if (!entry.monitor)
+                        entry.callback(args...);
+                    else if (!demote(*entry.monitor))
+                        call_measured(entry, [&entry, &args...]()
+                                      { entry.callback(args...); });
+                    else
+                    {
+                        share_payload();
+                        post_demoted(_subscriptions, index, payload);
+                    }
+                }
+                else if (entry.leader)
+                {
+                    share_payload();
+                    entry.target->post(
+                        [list = _subscriptions, payload, index]()
+                        {
+                            deliver(*list, *payload, index);
+                        });
+                }
+            }
+        }
+        else
+            for (const auto &entry : *_subscriptions)
+                entry.callback(args...);
+    }
+
+    /**
+     * @brief Call all callbacks subscribed to an executor
+     *
+     * @note Called by the executor
+     *
+     * @param list List of subscription entries at the time of dispatch
+     * @param payload Copy of the event data
+     * @param index Index of the leader entry
+     */
+    static void deliver(
+        const list_type &list,
+        const payload_type &payload,
+        ::std::size_t index)
+    {
+        for (; index != no_entry; index = list[index].next)
+            if (list[index].active->load(::std::memory_order_acquire))
+                ::std::apply(list[index].callback, payload);
+    }
+
+    /**
+     * @brief Check if a call must be posted to the fallback executor
+     *
+     * @note If so, a pending call is counted
+     *
+     * @param monitor Measurements of the callback
+     * @return true if demoted
+     * @return false if the callback must be called now
+     */
+    static bool demote(latency_monitor &monitor) noexcept
+    {
+        ::std::size_t state = monitor.state.load(::std::memory_order_acquire);
+        do
+            if (!(state & latency_monitor::demoted_bit))
+                return false;
+        while (!monitor.state.compare_exchange_weak(
+            state, state + 1,
+            ::std::memory_order_acq_rel,
+            ::std::memory_order_acquire));
+        return true;
+    }
+
+    /**
+     * @brief Call a callback and demote it if too slow
+     *
+     * @tparam Call Callable type
+     * @param entry Subscription entry
+     * @param call Calls the callback with the event data
+     */
+    template <class Call>
+    static void call_measured(const subscription_entry &entry, Call &&call)
+    {
+        ::std::int64_t budget =
+            entry.monitor->budget.load(::std::memory_order_relaxed);
+        if (!budget)
+        {
+            call();
+            return;
+        }
+        auto start = ::std::chrono::steady_clock::now();
+        call();
+        if (entry.monitor->record(::std::chrono::steady_clock::now() - start) >
+            budget)
+            entry.monitor->state.fetch_or(
+                latency_monitor::demoted_bit,
+                ::std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Post a call to a demoted callback
+     *
+     * @note Calls to the same callback are queued in its monitor
+     *       and executed by a single task at a time (a *strand*),
+     *       so they never overlap and keep the dispatch order
+     *       even if the fallback executor runs tasks in several threads.
+     *
+     * @param list Subscription entries at the time of dispatch
+     * @param index Index of the entry in @p list
+     * @param payload Copy of the event data
+     */
+    void post_demoted(
+        const ::std::shared_ptr<list_type> &list,
+        ::std::size_t index,
+        ::std::shared_ptr<const payload_type> payload) const
+    {
+        ::std::shared_ptr<latency_monitor> monitor = (*list)[index].monitor;
+        if (monitor->push({list, index, ::std::move(payload)}))
+            _fallback->post([monitor]()
+                            { drain(*monitor); });
+    }
+
+    /**
+     * @brief Execute the pending calls to a demoted callback
+     *
+     * @note Called by the fallback executor
+     *
+     * @param monitor Measurements of the callback
+     */
+    static void drain(latency_monitor &monitor)
+    {
+        demoted_call call;
+        while (monitor.front(call))
+        {
+            deliver_demoted((*call.list)[call.index], *call.payload);
+            monitor.pop_front();
+        }
+    }
+
+    /**
+     * @brief Call a demoted callback and promote it if fast enough
+     *
+     * @note Called by the fallback executor.
+     *       Promotion waits for all pending calls, so calls are not reordered.
+     *
+     * @param entry Subscription entry
+     * @param payload Copy of the event data
+     */
+    static void deliver_demoted(
+        const subscription_entry &entry,
+        const payload_type &payload)
+    {
+        latency_monitor &monitor = *entry.monitor;
+        if (monitor.active.load(::std::memory_order_acquire))
+        {
+            auto start = ::std::chrono::steady_clock::now();
+            ::std::apply(entry.callback, payload);
+            monitor.record(::std::chrono::steady_clock::now() - start);
+        }
+        ::std::int64_t budget = monitor.budget.load(::std::memory_order_relaxed);
+        bool recovered =
+            !budget ||
+            (monitor.average.load(::std::memory_order_relaxed) * 2 < budget);
+        ::std::size_t state = monitor.state.load(::std::memory_order_acquire);
+        ::std::size_t next;
+        do
+        {
+            next = state - 1;
+            if (recovered && (next == latency_monitor::demoted_bit))
+                next = 0;
+        } while (!monitor.state.compare_exchange_weak(
+            state, next,
+            ::std::memory_order_acq_rel,
+            ::std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Call or post a single subscribed callback (resumable dispatch)
+     *
+     * @note Must be called with the mutex locked for reading
+     * @note Callbacks unsubscribed since the snapshot was taken are skipped.
+     *       Callbacks subscribed to executors are posted by the leader
+     *       and skipped on delivery if unsubscribed.
+     *
+     * @param list Subscription entries at the time of dispatch
+     * @param index Index of the entry in @p list
+     * @param payload Copy of the event data
+     */
+    void resume_entry(
+        const ::std::shared_ptr<list_type> &list,
+        ::std::size_t index,
+        const ::std::shared_ptr<const payload_type> &payload) const
+    {
+        const auto &entry = (*list)[index];
+        if (entry.target)
+        {
+            if (entry.leader)
+                entry.target->post(
+                    [list, payload, index]()
+                    {
+                        deliver(*list, *payload, index);
+                    });
+            return;
+        }
+
+        if ((_subscriptions != list) && !contains(entry.id))
+            return;
+        if (!entry.monitor)
+            ::std::apply(entry.callback, *payload);
+        else if (!demote(*entry.monitor))
+            call_measured(entry, [&entry, &payload]()
+                          { ::std::apply(entry.callback, *payload); });
+        else
+            post_demoted(list, index, payload);
+    }
+
+    /**
+     * @brief Check if a subscription id is still subscribed
+     *
+     * @note Must be called with the mutex locked for reading
+     * @note Binary search
+     *
+     * @param id Subscription id
+     * @return true if subscribed
+     * @return false otherwise
+     */
+    bool contains(::std::size_t id) const noexcept
+    {
+        if (!_subscriptions)
+            return false;
+        auto found = ::std::lower_bound(
+            _subscriptions->begin(),
+            _subscriptions->end(),
+            id,
+            [](const subscription_entry &entry, ::std::size_t value)
+            {
+                return entry.id < value;
+            });
+        return (found != _subscriptions->end()) && (found->id == id);
+    }
+
+    /// @brief List of subscription entries (shared by copies, may be null)
+    ::std::shared_ptr<list_type> _subscriptions{};
+    /// @brief Count of subscriptions to executors
+    ::std::size_t _deferred{0};
+    /// @brief Maximum average call duration (zero means none)
+    ::std::chrono::nanoseconds _budget{0};
+    /// @brief Executor for demoted callbacks
+    ///        (not null once set_latency_budget() is called)
+    executor *_fallback{nullptr};
+    /// @brief Memory resource for subscriber storage
+    ::std::pmr::memory_resource *_resource{::std::pmr::get_default_resource()};
+    /// @brief Next subscription id (unique among all instances)
+    inline static ::std::atomic<::std::size_t> next_id{0};
     /// @brief Mutex for thread-safe operations
     mutable ::std::shared_mutex subscribe_mutex{};
 };
@@ -0,0 +1,132 @@
+/**
+ * @file executor.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Execution of callbacks in a thread of choice
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Executor of tasks
+ *
+ * @note Implementations must be thread-safe
+ */
+class executor
+{
+public:
+    /// @brief Task type
+    using task_type = ::std::function<void()>;
+
+    /**
+     * @brief Post a task for later execution
+     *
+     * @param task Task to be executed
+     */
+    virtual void post(task_type task) = 0;
+
+    /// @brief Destructor
+    virtual ~executor() noexcept = default;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Queue of tasks executed by a thread of choice
+ *
+ * @note Thread-safe
+ * @note Tasks are executed in posting order by the thread calling
+ *       run_pending() or wait_and_run_pending(),
+ *       typically a GUI or actor thread.
+ */
+class queue_executor : public executor
+{
+public:
+    /**
+     * @brief Post a task for later execution
+     *
+     * @param task Task to be executed
+     */
+    void post(task_type task) override
+    {
+        {
+            ::std::lock_guard<::std::mutex> guard(queue_mutex);
+            _tasks.push_back(::std::move(task));
+        }
+        tasks_available.notify_one();
+    }
+
+    /**
+     * @brief Execute all pending tasks in the calling thread
+     *
+     * @note Tasks posted meanwhile are not executed until the next call
+     *
+     * @return ::std::size_t Count of executed tasks
+     */
+    ::std::size_t run_pending()
+    {
+        ::std::deque<task_type> batch;
+        {
+            ::std::lock_guard<::std::mutex> guard(queue_mutex);
+            batch.swap(_tasks);
+        }
+        for (auto &task : batch)
+            task();
+        return batch.size();
+    }
+
+    /**
+     * @brief Wait for tasks and execute them in the calling thread
+     *
+     * @note Blocks until there is at least one pending task
+     *
+     * @return ::std::size_t Count of executed tasks
+     */
+    ::std::size_t wait_and_run_pending()
+    {
+        ::std::deque<task_type> batch;
+        {
+            ::std::unique_lock<::std::mutex> guard(queue_mutex);
+            tasks_available.wait(guard, [this]()
+                                 { return !_tasks.empty(); });
+            batch.swap(_tasks);
+        }
+        for (auto &task : batch)
+            task();
+        return batch.size();
+    }
+
+    /**
+     * @brief Get the number of pending tasks
+     *
+     * @return ::std::size_t Count of pending tasks
+     */
+    ::std::size_t pending() const
+    {
+        ::std::lock_guard<::std::mutex> guard(queue_mutex);
+        return _tasks.size();
+    }
+
+private:
+    /// @brief Pending tasks
+    ::std::deque<task_type> _tasks{};
+    /// @brief Mutex for thread-safe operations
+    mutable ::std::mutex queue_mutex{};
+    /// @brief Signaled when a task is posted
+    ::std::condition_variable tasks_available{};
+};
+
+//------------------------------------------------------------------------------
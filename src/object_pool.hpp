@@ -0,0 +1,222 @@
+/**
+ * @file object_pool.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Recycling of objects
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Per-thread pools of recycled objects
+ *
+ * @note Thread-safe
+ * @note Each thread acquires objects from its own pool.
+ *       Objects are released to the pool of the thread that acquired them:
+ *       without locks if released by the same thread,
+ *       through a lock-free stack otherwise.
+ * @note Memory is not returned to the system until the owning thread exits.
+ *       Thus, once a pool reaches its peak size,
+ *       acquiring and releasing objects does not allocate memory.
+ *
+ * @tparam T Object type
+ */
+template <class T>
+class object_pool
+{
+    struct pool_state;
+
+public:
+    /**
+     * @brief Pooled object
+     *
+     */
+    class node
+    {
+    public:
+        /// @brief Get the pooled object
+        /// @return T& Object
+        T &value() noexcept
+        {
+            return *::std::launder(reinterpret_cast<T *>(storage));
+        }
+
+        /// @brief Get the pooled object
+        /// @return const T& Object
+        const T &value() const noexcept
+        {
+            return *::std::launder(reinterpret_cast<const T *>(storage));
+        }
+
+        /// @brief Link to another node, free for use while acquired
+        node *next{nullptr};
+
+    private:
+        friend class object_pool<T>;
+        /// @brief Pool this node belongs to
+        pool_state *owner{nullptr};
+        /// @brief Storage for the pooled object
+        alignas(T) ::std::byte storage[sizeof(T)];
+    };
+
+    /**
+     * @brief Acquire an object from the pool of the calling thread
+     *
+     * @tparam CtorArgs Constructor argument types
+     * @param args Constructor arguments
+     * @return node* Pooled object
+     */
+    template <class... CtorArgs>
+    static node *acquire(CtorArgs &&...args)
+    {
+        pool_state &state = local();
+        node *result = state.free_list;
+        if (!result)
+            result = state.returned.exchange(nullptr, ::std::memory_order_acquire);
+        if (result)
+            state.free_list = result->next;
+        else
+        {
+            result = new node();
+            result->owner = &state;
+            state.refs.fetch_add(1, ::std::memory_order_relaxed);
+        }
+        try
+        {
+            ::new (static_cast<void *>(result->storage))
+                T(::std::forward<CtorArgs>(args)...);
+        }
+        catch (...)
+        {
+            result->next = state.free_list;
+            state.free_list = result;
+            throw;
+        }
+        result->next = nullptr;
+        return result;
+    }
+
+    /**
+     * @brief Destroy an object and return it to its pool
+     *
+     * @note Any thread may release any object
+     *
+     * @param object Object returned by acquire()
+     */
+    static void release(node *object) noexcept
+    {
+        object->value().~T();
+        pool_state *owner = object->owner;
+        if (owner == &local())
+        {
+            object->next = owner->free_list;
+            owner->free_list = object;
+            return;
+        }
+
+        // Keep the owner alive while returning the object
+        owner->refs.fetch_add(1, ::std::memory_order_relaxed);
+        node *head = owner->returned.load(::std::memory_order_relaxed);
+        do
+            object->next = head;
+        while (!owner->returned.compare_exchange_weak(
+            head, object,
+            ::std::memory_order_seq_cst,
+            ::std::memory_order_relaxed));
+        if (owner->orphaned.load(::std::memory_order_seq_cst))
+            // The owning thread is gone: nobody else will recycle it
+            drop(owner, destroy(owner->returned.exchange(
+                            nullptr, ::std::memory_order_seq_cst)));
+        drop(owner, 1);
+    }
+
+private:
+    /// @brief Pool of a single thread
+    struct pool_state
+    {
+        /// @brief Objects released by the owning thread (owner only)
+        node *free_list{nullptr};
+        /// @brief Objects released by other threads (lock-free stack)
+        ::std::atomic<node *> returned{nullptr};
+        /// @brief One for the owning thread plus one per existing node
+        ::std::atomic<::std::size_t> refs{1};
+        /// @brief True after the owning thread exits
+        ::std::atomic<bool> orphaned{false};
+    };
+
+    /// @brief Orphans the pool of a thread on exit
+    struct local_holder
+    {
+        /// @brief Pool of this thread
+        pool_state *state{new pool_state()};
+
+        ~local_holder()
+        {
+            state->orphaned.store(true, ::std::memory_order_seq_cst);
+            ::std::size_t count = destroy(state->free_list);
+            count += destroy(state->returned.exchange(
+                nullptr, ::std::memory_order_seq_cst));
+            drop(state, count + 1);
+        }
+    };
+
+    /**
+     * @brief Get the pool of the calling thread
+     *
+     * @return pool_state& Pool
+     */
+    static pool_state &local()
+    {
+        thread_local local_holder holder{};
+        return *holder.state;
+    }
+
+    /**
+     * @brief Delete a list of free nodes
+     *
+     * @param list First node
+     * @return ::std::size_t Count of deleted nodes
+     */
+    static ::std::size_t destroy(node *list) noexcept
+    {
+        ::std::size_t count = 0;
+        while (list)
+        {
+            node *next = list->next;
+            delete list;
+            list = next;
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Release references to a pool
+     *
+     * @note The pool is deleted with the last reference
+     *
+     * @param state Pool
+     * @param count Count of references
+     */
+    static void drop(pool_state *state, ::std::size_t count) noexcept
+    {
+        if (count &&
+            (state->refs.fetch_sub(count, ::std::memory_order_acq_rel) == count))
+            delete state;
+    }
+};
+
+//------------------------------------------------------------------------------
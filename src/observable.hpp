@@ -93,12 +93,12 @@ struct observable
     }
 
     /// @brief Postfix increment
-    /// @return Copy of this instance holding the previous value
-    constexpr type operator++(int)
+    /// @return Previous value
+    constexpr T operator++(int)
     {
-        T old_instance = *this;
+        T old_value = _var;
         operator++();
-        return old_instance;
+        return old_value;
     }
 
     /// @brief Prefix decrement
@@ -112,12 +112,12 @@ struct observable
     }
 
     /// @brief Postfix decrement
-    /// @return Copy of this instance holding the previous value
-    constexpr type operator--(int)
+    /// @return Previous value
+    constexpr T operator--(int)
     {
-        T old_instance = *this;
+        T old_value = _var;
         operator--();
-        return old_instance;
+        return old_value;
     }
 
     /// @brief Compound increment
@@ -208,6 +208,39 @@ struct observable
         return *this;
     }
 
+    //.... Write and retrieve the previous value ....
+    //     Same as std::atomic, but not atomic
+
+    /// @brief Assign a new value
+    /// @param value Value to be assigned
+    /// @return Previous value
+    constexpr T exchange(const T &value)
+    {
+        T old_value = _var;
+        operator=(value);
+        return old_value;
+    }
+
+    /// @brief Compound increment
+    /// @param rhs Value to add
+    /// @return Previous value
+    constexpr T fetch_add(const T &rhs)
+    {
+        T old_value = _var;
+        operator+=(rhs);
+        return old_value;
+    }
+
+    /// @brief Compound decrement
+    /// @param rhs Value to substract
+    /// @return Previous value
+    constexpr T fetch_sub(const T &rhs)
+    {
+        T old_value = _var;
+        operator-=(rhs);
+        return old_value;
+    }
+
     //.... Backing variable access without a context ....
     //     Easier but prone to human mistake
     //     Uncomment if you wish.
@@ -0,0 +1,443 @@
+/**
+ * @file pipeline.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Operator pipelines over events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <concepts>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Operators for event pipelines
+ *
+ * @note A pipeline is written as
+ *       `source | ops::filter(p) | ops::map(f) | ops::sink(h)`.
+ *       All the operators are fused into a single callback,
+ *       which is the only one subscribed to the source event.
+ *       There are no intermediate events, no intermediate copies
+ *       of the event data and no allocations per dispatch.
+ * @note Operators are in their own namespace
+ *       to avoid clashes with `std::map`.
+ */
+namespace ops
+{
+    //--------------------------------------------------------------------------
+    // Stages (fused callbacks)
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Last stage: calls the handler
+     *
+     * @tparam Handler Handler type
+     */
+    template <class Handler>
+    struct sink_stage
+    {
+        /// @brief Handler
+        Handler handler;
+
+        /**
+         * @brief Call the handler
+         *
+         * @param values Values from the previous stage
+         */
+        template <class... Values>
+        void operator()(Values &&...values)
+        {
+            ::std::invoke(handler, ::std::forward<Values>(values)...);
+        }
+    };
+
+    /**
+     * @brief Stage passing through values satisfying a predicate
+     *
+     * @tparam Predicate Predicate type
+     * @tparam Next Next stage type
+     */
+    template <class Predicate, class Next>
+    struct filter_stage
+    {
+        /// @brief Predicate
+        Predicate predicate;
+        /// @brief Next stage
+        Next next;
+
+        /**
+         * @brief Call the next stage if the predicate is satisfied
+         *
+         * @param values Values from the previous stage
+         */
+        template <class... Values>
+        void operator()(Values &&...values)
+        {
+            if (::std::invoke(predicate, ::std::as_const(values)...))
+                next(::std::forward<Values>(values)...);
+        }
+    };
+
+    /**
+     * @brief Stage transforming values
+     *
+     * @tparam Function Transformation type
+     * @tparam Next Next stage type
+     */
+    template <class Function, class Next>
+    struct map_stage
+    {
+        /// @brief Transformation
+        Function function;
+        /// @brief Next stage
+        Next next;
+
+        /**
+         * @brief Call the next stage with the transformed value
+         *
+         * @param values Values from the previous stage
+         */
+        template <class... Values>
+        void operator()(Values &&...values)
+        {
+            next(::std::invoke(function, ::std::forward<Values>(values)...));
+        }
+    };
+
+    /**
+     * @brief Stage accumulating values
+     *
+     * @tparam Function Accumulation type
+     * @tparam State Accumulated value type
+     * @tparam Next Next stage type
+     */
+    template <class Function, class State, class Next>
+    struct scan_stage
+    {
+        /// @brief Accumulation
+        Function function;
+        /// @brief Accumulated value
+        State state;
+        /// @brief Next stage
+        Next next;
+
+        /**
+         * @brief Accumulate and call the next stage with the accumulated value
+         *
+         * @param values Values from the previous stage
+         */
+        template <class... Values>
+        void operator()(Values &&...values)
+        {
+            state = ::std::invoke(
+                function,
+                ::std::move(state),
+                ::std::forward<Values>(values)...);
+            next(::std::as_const(state));
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    // Operators
+    //--------------------------------------------------------------------------
+
+    /// @brief Base of all operators
+    struct operator_base
+    {
+    };
+
+    /**
+     * @brief Filter operator
+     *
+     * @tparam Predicate Predicate type
+     */
+    template <class Predicate>
+    struct filter_operator : operator_base
+    {
+        /// @brief Predicate
+        Predicate predicate;
+
+        /**
+         * @brief Fuse with the next stage
+         *
+         * @tparam Next Next stage type
+         * @param next Next stage
+         * @return filter_stage<Predicate, Next> Fused stage
+         */
+        template <class Next>
+        filter_stage<Predicate, Next> then(Next next) &&
+        {
+            return {::std::move(predicate), ::std::move(next)};
+        }
+    };
+
+    /**
+     * @brief Map operator
+     *
+     * @tparam Function Transformation type
+     */
+    template <class Function>
+    struct map_operator : operator_base
+    {
+        /// @brief Transformation
+        Function function;
+
+        /**
+         * @brief Fuse with the next stage
+         *
+         * @tparam Next Next stage type
+         * @param next Next stage
+         * @return map_stage<Function, Next> Fused stage
+         */
+        template <class Next>
+        map_stage<Function, Next> then(Next next) &&
+        {
+            return {::std::move(function), ::std::move(next)};
+        }
+    };
+
+    /**
+     * @brief Scan operator
+     *
+     * @tparam Function Accumulation type
+     * @tparam State Accumulated value type
+     */
+    template <class Function, class State>
+    struct scan_operator : operator_base
+    {
+        /// @brief Accumulation
+        Function function;
+        /// @brief Initial value
+        State initial;
+
+        /**
+         * @brief Fuse with the next stage
+         *
+         * @tparam Next Next stage type
+         * @param next Next stage
+         * @return scan_stage<Function, State, Next> Fused stage
+         */
+        template <class Next>
+        scan_stage<Function, State, Next> then(Next next) &&
+        {
+            return {::std::move(function), ::std::move(initial), ::std::move(next)};
+        }
+    };
+
+    /**
+     * @brief Sink operator (ends a pipeline)
+     *
+     * @tparam Handler Handler type
+     */
+    template <class Handler>
+    struct sink_operator : operator_base
+    {
+        /// @brief Handler
+        Handler handler;
+    };
+
+    /**
+     * @brief Pass through values satisfying a predicate
+     *
+     * @tparam Predicate Predicate type
+     * @param predicate Returns true to pass the values through
+     * @return filter_operator<::std::decay_t<Predicate>> Operator
+     */
+    template <class Predicate>
+    filter_operator<::std::decay_t<Predicate>> filter(Predicate &&predicate)
+    {
+        return {{}, ::std::forward<Predicate>(predicate)};
+    }
+
+    /**
+     * @brief Transform values
+     *
+     * @note Next stages receive a single value
+     *
+     * @tparam Function Transformation type
+     * @param function Returns the transformed value
+     * @return map_operator<::std::decay_t<Function>> Operator
+     */
+    template <class Function>
+    map_operator<::std::decay_t<Function>> map(Function &&function)
+    {
+        return {{}, ::std::forward<Function>(function)};
+    }
+
+    /**
+     * @brief Accumulate values
+     *
+     * @note Next stages receive the accumulated value
+     * @note The accumulated value is kept between dispatches
+     *       and it is not synchronized: the source event must not
+     *       be dispatched concurrently
+     *
+     * @tparam Function Accumulation type
+     * @tparam State Accumulated value type
+     * @param function Takes the accumulated value and the values
+     *                 and returns the new accumulated value
+     * @param initial Initial accumulated value
+     * @return scan_operator<::std::decay_t<Function>, ::std::decay_t<State>> Operator
+     */
+    template <class Function, class State>
+    scan_operator<::std::decay_t<Function>, ::std::decay_t<State>> scan(
+        Function &&function,
+        State &&initial)
+    {
+        return {{}, ::std::forward<Function>(function), ::std::forward<State>(initial)};
+    }
+
+    /**
+     * @brief End a pipeline
+     *
+     * @tparam Handler Handler type
+     * @param handler Takes the values from the previous stage
+     * @return sink_operator<::std::decay_t<Handler>> Operator
+     */
+    template <class Handler>
+    sink_operator<::std::decay_t<Handler>> sink(Handler &&handler)
+    {
+        return {{}, ::std::forward<Handler>(handler)};
+    }
+
+    //--------------------------------------------------------------------------
+    // Pipelines
+    //--------------------------------------------------------------------------
+
+    /**
+     * @brief Pipeline not subscribed yet (not ended by a sink)
+     *
+     * @tparam Source Source event type
+     * @tparam Operators Operator types
+     */
+    template <class Source, class... Operators>
+    struct chain
+    {
+        /// @brief Source event
+        Source &source;
+        /// @brief Operators
+        ::std::tuple<Operators...> operators;
+    };
+
+    /// @brief Operator (excluding sinks)
+    template <class T>
+    concept stage_operator =
+        ::std::derived_from<T, operator_base> &&
+        requires(T op) { ::std::move(op).then(sink_stage<int>{0}); };
+
+    /// @brief Event to be used as a pipeline source
+    template <class T>
+    concept source_event =
+        requires(T &source, typename T::callback_type callback) {
+            source.subscribe(callback);
+        };
+
+    /**
+     * @brief Fuse operators with their next stage, from last to first
+     *
+     * @tparam Index Count of operators yet to fuse
+     * @tparam Operators Operator types
+     * @tparam Next Next stage type
+     * @param operators Operators
+     * @param next Stage after the last operator yet to fuse
+     * @return auto Fused stage
+     */
+    template <::std::size_t Index, class... Operators, class Next>
+    auto fuse(::std::tuple<Operators...> &operators, Next next)
+    {
+        if constexpr (Index == 0)
+            return next;
+        else
+            return fuse<Index - 1>(
+                operators,
+                ::std::move(::std::get<Index - 1>(operators)).then(::std::move(next)));
+    }
+
+    /**
+     * @brief Start a pipeline
+     *
+     * @tparam Source Source event type
+     * @tparam Operator Operator type
+     * @param source Source event
+     * @param op First operator
+     * @return chain<Source, Operator> Pipeline not subscribed yet
+     */
+    template <source_event Source, stage_operator Operator>
+    chain<Source, Operator> operator|(Source &source, Operator op)
+    {
+        return {source, {::std::move(op)}};
+    }
+
+    /**
+     * @brief Append an operator to a pipeline
+     *
+     * @tparam Source Source event type
+     * @tparam Operators Operator types
+     * @tparam Operator Operator type
+     * @param pipeline Pipeline not subscribed yet
+     * @param op Operator
+     * @return chain<Source, Operators..., Operator> Pipeline not subscribed yet
+     */
+    template <class Source, class... Operators, stage_operator Operator>
+    chain<Source, Operators..., Operator> operator|(
+        chain<Source, Operators...> &&pipeline,
+        Operator op)
+    {
+        return {
+            pipeline.source,
+            ::std::tuple_cat(
+                ::std::move(pipeline.operators),
+                ::std::tuple<Operator>(::std::move(op)))};
+    }
+
+    /**
+     * @brief End a pipeline and subscribe it to the source event
+     *
+     * @tparam Source Source event type
+     * @tparam Operators Operator types
+     * @tparam Handler Handler type
+     * @param pipeline Pipeline not subscribed yet
+     * @param end Sink operator
+     * @return auto Subscription handler of the source event
+     */
+    template <class Source, class... Operators, class Handler>
+    auto operator|(
+        chain<Source, Operators...> &&pipeline,
+        sink_operator<Handler> end)
+    {
+        auto fused = fuse<sizeof...(Operators)>(
+            pipeline.operators,
+            sink_stage<Handler>{::std::move(end.handler)});
+        return pipeline.source.subscribe(
+            [fused = ::std::move(fused)](const auto &...args) mutable
+            { fused(args...); });
+    }
+
+    /**
+     * @brief Subscribe a sink to the source event
+     *
+     * @tparam Source Source event type
+     * @tparam Handler Handler type
+     * @param source Source event
+     * @param end Sink operator
+     * @return auto Subscription handler of the source event
+     */
+    template <source_event Source, class Handler>
+    auto operator|(Source &source, sink_operator<Handler> end)
+    {
+        return chain<Source>{source, {}} | ::std::move(end);
+    }
+} // namespace ops
+
+//------------------------------------------------------------------------------
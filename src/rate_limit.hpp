@@ -0,0 +1,332 @@
+/**
+ * @file rate_limit.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Throttle, debounce and sample adapters for events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "event.hpp"
+#include "timer_wheel.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Common base of throttler, debouncer and sampler
+ *
+ * @note Subscribes to a source event and dispatches a downstream event
+ *       with less event data, as timers of a timer wheel expire.
+ * @note Just the latest pending event data is stored.
+ *       No memory is allocated per dispatch in the steady state.
+ * @note Thread-safe. Timed dispatches happen in the thread calling
+ *       timer_wheel::advance().
+ * @warning Must not be destroyed while the source is dispatching
+ *          or the timer wheel is advancing.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class rate_limiter
+{
+public:
+    /// @brief Copy of the event data
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+    /// @brief Duration type
+    using duration = timer_wheel::duration;
+
+    /**
+     * @brief Get the interval
+     *
+     * @return duration Interval given on construction
+     */
+    duration interval() const noexcept
+    {
+        return _interval;
+    }
+
+    /**
+     * @brief Get the count of suppressed event data
+     *
+     * @return ::std::size_t Count of source dispatches not forwarded
+     *         downstream since construction
+     */
+    ::std::size_t suppressed() const
+    {
+        ::std::lock_guard<::std::mutex> guard(state_mutex);
+        return _suppressed;
+    }
+
+    /**
+     * @brief Unsubscribe from the source and cancel the pending timer
+     *
+     */
+    ~rate_limiter()
+    {
+        _source.unsubscribe(_subscription);
+        ::std::lock_guard<::std::mutex> guard(state_mutex);
+        _timers.cancel(_timer);
+    }
+
+    /// @brief Copy constructor (deleted)
+    rate_limiter(const rate_limiter &) = delete;
+    /// @brief Copy-assignment (deleted)
+    rate_limiter &operator=(const rate_limiter &) = delete;
+
+protected:
+    /// @brief Behavior of the derived adapter
+    enum class mode : ::std::uint8_t
+    {
+        throttle,
+        debounce,
+        sample
+    };
+
+    /**
+     * @brief Subscribe to the source
+     *
+     * @param behavior Behavior
+     * @param source Source event
+     * @param downstream Downstream event
+     * @param timers Timer wheel
+     * @param interval Interval
+     */
+    rate_limiter(
+        mode behavior,
+        event<Args...> &source,
+        event<Args...> &downstream,
+        timer_wheel &timers,
+        duration interval)
+        : _mode{behavior},
+          _source{source},
+          _downstream{downstream},
+          _timers{timers},
+          _interval{interval}
+    {
+        if (_mode == mode::sample)
+            _timer = _timers.schedule_every(_interval, [this]()
+                                            { expire(); });
+        _subscription = _source.subscribe(
+            [this](const Args &...args)
+            { receive(args...); });
+    }
+
+private:
+    /**
+     * @brief Handle source event data
+     *
+     * @param args Event data
+     */
+    void receive(const Args &...args)
+    {
+        ::std::unique_lock<::std::mutex> guard(state_mutex);
+        if ((_mode == mode::throttle) && !_timer.is_valid())
+        {
+            // Leading edge: forward now and open the window
+            _timer = _timers.schedule_after(_interval, [this]()
+                                            { expire(); });
+            guard.unlock();
+            _downstream(args...);
+            return;
+        }
+        if (_pending)
+            _suppressed++;
+        // Note: assignment reuses the storage of the previous event data
+        if (_latest)
+            *_latest = ::std::forward_as_tuple(args...);
+        else
+            _latest.emplace(args...);
+        _pending = true;
+        if (_mode == mode::debounce)
+        {
+            _deadline = _timers.now() + _interval;
+            if (!_timer.is_valid())
+                _timer = _timers.schedule_at(_deadline, [this]()
+                                             { expire(); });
+        }
+    }
+
+    /**
+     * @brief Handle timer expiration
+     *
+     */
+    void expire()
+    {
+        ::std::unique_lock<::std::mutex> guard(state_mutex);
+        switch (_mode)
+        {
+        case mode::throttle:
+            // Trailing edge: forward the latest event data (if any)
+            // and keep the window open
+            _timer = timer_wheel::timer_handle();
+            if (_pending)
+                _timer = _timers.schedule_after(_interval, [this]()
+                                                { expire(); });
+            break;
+        case mode::debounce:
+            _timer = timer_wheel::timer_handle();
+            if (_timers.now() < _deadline)
+            {
+                // Not quiet yet
+                _timer = _timers.schedule_at(_deadline, [this]()
+                                             { expire(); });
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        if (!_pending)
+            return;
+        _pending = false;
+        // Note: the timer wheel advances in one thread at a time,
+        // so _emitting is not shared
+        _latest.swap(_emitting);
+        guard.unlock();
+        ::std::apply(_downstream, *_emitting);
+    }
+
+    /// @brief Behavior
+    mode _mode;
+    /// @brief Source event
+    event<Args...> &_source;
+    /// @brief Downstream event
+    event<Args...> &_downstream;
+    /// @brief Timer wheel
+    timer_wheel &_timers;
+    /// @brief Interval
+    duration _interval;
+    /// @brief Subscription to the source
+    typename event<Args...>::subscription_handler _subscription{};
+    /// @brief Pending timer (if any)
+    timer_wheel::timer_handle _timer{};
+    /// @brief End of the quiet period (debounce only)
+    timer_wheel::time_point _deadline{};
+    /// @brief Latest event data
+    ::std::optional<payload_type> _latest{};
+    /// @brief Event data being forwarded by a timer
+    ::std::optional<payload_type> _emitting{};
+    /// @brief True if _latest has not been forwarded yet
+    bool _pending{false};
+    /// @brief Count of suppressed event data
+    ::std::size_t _suppressed{0};
+    /// @brief Mutex for the state
+    mutable ::std::mutex state_mutex{};
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Forward event data at most once per interval
+ *
+ * @note Event data is forwarded immediately if no event data was forwarded
+ *       during the last interval. Otherwise, the latest event data
+ *       is forwarded at the end of the interval.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class throttler : public rate_limiter<Args...>
+{
+public:
+    /**
+     * @brief Create a throttler
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @param source Source event
+     * @param downstream Downstream event
+     * @param timers Timer wheel
+     * @param interval Minimum time between forwarded event data
+     */
+    throttler(
+        event<Args...> &source,
+        event<Args...> &downstream,
+        timer_wheel &timers,
+        timer_wheel::duration interval)
+        : rate_limiter<Args...>(
+              rate_limiter<Args...>::mode::throttle,
+              source, downstream, timers, interval) {}
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Forward the latest event data after a quiet period
+ *
+ * @note Event data is forwarded when no other event data is dispatched
+ *       during an interval
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class debouncer : public rate_limiter<Args...>
+{
+public:
+    /**
+     * @brief Create a debouncer
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @param source Source event
+     * @param downstream Downstream event
+     * @param timers Timer wheel
+     * @param interval Quiet period
+     */
+    debouncer(
+        event<Args...> &source,
+        event<Args...> &downstream,
+        timer_wheel &timers,
+        timer_wheel::duration interval)
+        : rate_limiter<Args...>(
+              rate_limiter<Args...>::mode::debounce,
+              source, downstream, timers, interval) {}
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Forward the latest event data periodically
+ *
+ * @note Nothing is forwarded if no event data was dispatched
+ *       during the last period
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class sampler : public rate_limiter<Args...>
+{
+public:
+    /**
+     * @brief Create a sampler
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @param source Source event
+     * @param downstream Downstream event
+     * @param timers Timer wheel
+     * @param period Sampling period
+     */
+    sampler(
+        event<Args...> &source,
+        event<Args...> &downstream,
+        timer_wheel &timers,
+        timer_wheel::duration period)
+        : rate_limiter<Args...>(
+              rate_limiter<Args...>::mode::sample,
+              source, downstream, timers, period) {}
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,263 @@
+/**
+ * @file spsc_channel.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (one producer thread, one consumer thread)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include "event.hpp"
+#include "wait_strategy.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Event dispatched in one thread and delivered in another thread
+ *
+ * @note Dispatching copies the event data into a ring buffer.
+ *       A single consumer thread delivers it to all subscribed callbacks
+ *       in dispatch order by calling poll() or wait_and_poll().
+ * @note Just one thread may dispatch and just one thread may poll.
+ *       Subscribing and unsubscribing are thread-safe.
+ * @note try_dispatch() and poll() are wait-free.
+ *
+ * @tparam Args Callback argument types
+ */
+template <class... Args>
+class spsc_channel : private event<Args...>
+{
+    /// @brief Subscriber storage and synchronous dispatch
+    using base = event<Args...>;
+
+public:
+    /// @brief This type
+    using type = spsc_channel<Args...>;
+    /// @brief Callback type
+    using typename base::callback_type;
+    /// @brief Subscription handler for managing callback lifetimes
+    using typename base::subscription_handler;
+    /// @brief Copy of the event data
+    using payload_type = ::std::tuple<::std::decay_t<Args>...>;
+
+    using base::clear;
+    using base::emplace;
+    using base::subscribe;
+    using base::subscribed;
+    using base::unsubscribe;
+
+    /**
+     * @brief Subscribe forever
+     *
+     * @warning @p callback must exceed the lifetime of this instance
+     *
+     * @param callback Callback function to be called on event delivery
+     * @return type& This instance
+     */
+    type &operator+=(const callback_type &callback) noexcept
+    {
+        subscribe(callback);
+        return *this;
+    }
+
+    /**
+     * @brief Unsubscribe
+     *
+     * @note No effect if @p h is invalid or already unsubscribed
+     *
+     * @param h Subscription handler returned by subscribe()
+     * @return type& This instance
+     */
+    type &operator-=(subscription_handler &h) noexcept
+    {
+        unsubscribe(h);
+        return *this;
+    }
+
+    /**
+     * @brief Dispatch event (producer thread only)
+     *
+     * @note Waits for room if the ring is full
+     *
+     * @param args Event data
+     */
+    void operator()(const Args &...args)
+    {
+        if (full())
+            _producer.wait(
+                _consumed_point,
+                [this]()
+                { return !full(); });
+        push(args...);
+    }
+
+    /**
+     * @brief Dispatch event if there is room (producer thread only)
+     *
+     * @param args Event data
+     * @return true if dispatched
+     * @return false if the ring is full
+     */
+    bool try_dispatch(const Args &...args)
+    {
+        if (full())
+            return false;
+        push(args...);
+        return true;
+    }
+
+    /**
+     * @brief Deliver dispatched event data (consumer thread only)
+     *
+     * @note Does not wait
+     *
+     * @param max_count Maximum count of event data to deliver.
+     *                  Zero means no limit.
+     * @return ::std::size_t Count of delivered event data
+     */
+    ::std::size_t poll(::std::size_t max_count = 0)
+    {
+        ::std::size_t head = _head.load(::std::memory_order_relaxed);
+        if (_tail_cache == head)
+        {
+            _tail_cache = _tail.load(::std::memory_order_seq_cst);
+            if (_tail_cache == head)
+                return 0;
+        }
+        ::std::size_t end = _tail_cache;
+        if (max_count && (end - head > max_count))
+            end = head + max_count;
+        for (::std::size_t index = head; index < end; index++)
+        {
+            auto &slot = _slots[index & _mask];
+            ::std::apply(
+                [this](const auto &...data)
+                { base::operator()(data...); },
+                *slot);
+            slot.reset();
+        }
+        // Note: the consumer index is published once per batch
+        _head.store(end, ::std::memory_order_seq_cst);
+        _consumed_point.notify();
+        return end - head;
+    }
+
+    /**
+     * @brief Wait for event data and deliver it (consumer thread only)
+     *
+     * @param max_count Maximum count of event data to deliver.
+     *                  Zero means no limit.
+     * @return ::std::size_t Count of delivered event data
+     */
+    ::std::size_t wait_and_poll(::std::size_t max_count = 0)
+    {
+        _consumer.wait(
+            _published_point,
+            [this]()
+            {
+                return (_tail.load(::std::memory_order_seq_cst) !=
+                        _head.load(::std::memory_order_relaxed));
+            });
+        return poll(max_count);
+    }
+
+    /**
+     * @brief Get the size of the ring
+     *
+     * @return ::std::size_t Maximum count of undelivered event data
+     */
+    ::std::size_t capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief Create a channel
+     *
+     * @param capacity Maximum count of undelivered event data
+     *                 (rounded up to a power of two)
+     * @param strategy How producer and consumer wait for each other
+     */
+    explicit spsc_channel(
+        ::std::size_t capacity = 1024,
+        wait_strategy strategy = wait_strategy::block)
+        : _capacity{::std::bit_ceil(::std::max<::std::size_t>(capacity, 1))},
+          _mask{_capacity - 1},
+          _slots{::std::make_unique<::std::optional<payload_type>[]>(_capacity)},
+          _consumer{strategy},
+          _producer{strategy} {}
+
+    /// @brief Copy constructor (deleted)
+    spsc_channel(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Check if the ring is full (producer thread only)
+     *
+     * @return true if full
+     * @return false otherwise
+     */
+    bool full()
+    {
+        ::std::size_t tail = _tail.load(::std::memory_order_relaxed);
+        if (tail - _head_cache < _capacity)
+            return false;
+        _head_cache = _head.load(::std::memory_order_seq_cst);
+        return (tail - _head_cache >= _capacity);
+    }
+
+    /**
+     * @brief Copy event data into the ring (producer thread only)
+     *
+     * @param args Event data
+     */
+    void push(const Args &...args)
+    {
+        ::std::size_t tail = _tail.load(::std::memory_order_relaxed);
+        _slots[tail & _mask].emplace(args...);
+        _tail.store(tail + 1, ::std::memory_order_seq_cst);
+        _published_point.notify();
+    }
+
+    /// @brief Count of slots (power of two)
+    ::std::size_t _capacity;
+    /// @brief Capacity minus one
+    ::std::size_t _mask;
+    /// @brief Ring of slots
+    ::std::unique_ptr<::std::optional<payload_type>[]> _slots;
+
+    /// @brief Index of the next event data to deliver (written by consumer)
+    alignas(64) ::std::atomic<::std::size_t> _head{0};
+    /// @brief Last known value of _tail (consumer only)
+    ::std::size_t _tail_cache{0};
+    /// @brief Consumer's waiter
+    waiter _consumer;
+    /// @brief Where the producer waits for consumption
+    wait_point _consumed_point{};
+
+    /// @brief Index of the next free slot (written by producer)
+    alignas(64) ::std::atomic<::std::size_t> _tail{0};
+    /// @brief Last known value of _head (producer only)
+    ::std::size_t _head_cache{0};
+    /// @brief Producer's waiter
+    waiter _producer;
+    /// @brief Where the consumer waits for dispatch
+    wait_point _published_point{};
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,403 @@
+/**
+ * @file thread_pool.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Execution of callbacks in a pool of threads
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "executor.hpp"
+#include "wait_strategy.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Work-stealing pool of threads
+ *
+ * @note Thread-safe
+ * @note Tasks posted by a worker thread are pushed to its own queue
+ *       (last in, first out). Tasks posted by any other thread are pushed
+ *       to a shared queue (first in, first out). Idle workers steal tasks
+ *       from the queues of other workers.
+ * @note Idle workers wait for tasks as given by a wait strategy.
+ *       By default, they spin for a while (adapted to the observed
+ *       time between tasks), then yield, then sleep until a task is posted.
+ * @note Tasks must not throw exceptions.
+ */
+class thread_pool : public executor
+{
+public:
+    /**
+     * @brief Create and start a pool of threads
+     *
+     * @param workers Count of worker threads.
+     *                Zero means one per hardware thread.
+     * @param pin_threads True to bind each worker to a CPU
+     *                    (ignored in platforms other than Linux)
+     * @param idle How idle workers wait for tasks
+     */
+    explicit thread_pool(
+        ::std::size_t workers = 0,
+        bool pin_threads = false,
+        wait_strategy idle = wait_strategy::adaptive)
+        : _idle{idle}
+    {
+        if (workers == 0)
+            workers = ::std::thread::hardware_concurrency();
+        if (workers == 0)
+            workers = 1;
+        _workers.reserve(workers);
+        for (::std::size_t index = 0; index < workers; index++)
+            _workers.push_back(::std::make_unique<worker>());
+        for (::std::size_t index = 0; index < workers; index++)
+        {
+            _workers[index]->thread = ::std::thread(&thread_pool::run, this, index);
+            if (pin_threads)
+                pin(_workers[index]->thread, index);
+        }
+    }
+
+    /**
+     * @brief Stop and join all worker threads
+     *
+     * @note Pending tasks are executed before returning
+     */
+    ~thread_pool() noexcept
+    {
+        stopping.store(true, ::std::memory_order_seq_cst);
+        wake_point.notify();
+        for (auto &w : _workers)
+            w->thread.join();
+        for (task_type *node : _injected)
+            delete node;
+    }
+
+    /// @brief Copy constructor (deleted)
+    thread_pool(const thread_pool &) = delete;
+    /// @brief Copy-assignment (deleted)
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    /**
+     * @brief Post a task for later execution
+     *
+     * @param task Task to be executed
+     */
+    void post(task_type task) override
+    {
+        task_type *node = new task_type(::std::move(task));
+        if (current_pool == this)
+            _workers[current_index]->tasks.push(node);
+        else
+        {
+            ::std::lock_guard<::std::mutex> guard(inject_mutex);
+            _injected.push_back(node);
+            injected_count.store(_injected.size(), ::std::memory_order_seq_cst);
+        }
+        wake_point.notify_one();
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     *
+     * @return ::std::size_t Count of worker threads
+     */
+    ::std::size_t size() const noexcept
+    {
+        return _workers.size();
+    }
+
+    /**
+     * @brief Pool of threads shared by the whole process
+     *
+     * @note Default executor for asynchronous dispatch.
+     *       One worker per hardware thread.
+     *
+     * @return thread_pool& Shared instance
+     */
+    static thread_pool &shared()
+    {
+        static thread_pool instance{};
+        return instance;
+    }
+
+private:
+    /**
+     * @brief Chase-Lev work-stealing deque
+     *
+     * @note Only the owner pushes and takes (bottom end).
+     *       Any thread may steal (top end).
+     */
+    class work_deque
+    {
+    public:
+        /// @brief Destroy pending tasks
+        ~work_deque() noexcept
+        {
+            while (task_type *node = take())
+                delete node;
+        }
+
+        /**
+         * @brief Push a task (owner only)
+         *
+         * @param node Task
+         */
+        void push(task_type *node)
+        {
+            ::std::int64_t b = bottom.load(::std::memory_order_relaxed);
+            ::std::int64_t t = top.load(::std::memory_order_acquire);
+            ring *r = buffer.load(::std::memory_order_relaxed);
+            if (b - t > static_cast<::std::int64_t>(r->mask))
+                r = grow(r, t, b);
+            r->put(b, node);
+            bottom.store(b + 1, ::std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Take the last pushed task (owner only)
+         *
+         * @return task_type* Task or null if empty
+         */
+        task_type *take()
+        {
+            ::std::int64_t b = bottom.load(::std::memory_order_relaxed) - 1;
+            ring *r = buffer.load(::std::memory_order_relaxed);
+            bottom.store(b, ::std::memory_order_seq_cst);
+            ::std::int64_t t = top.load(::std::memory_order_seq_cst);
+            if (t > b)
+            {
+                // Empty
+                bottom.store(b + 1, ::std::memory_order_relaxed);
+                return nullptr;
+            }
+            task_type *node = r->get(b);
+            if (t == b)
+            {
+                // Last task: race against thieves
+                if (!top.compare_exchange_strong(
+                        t, t + 1,
+                        ::std::memory_order_seq_cst,
+                        ::std::memory_order_relaxed))
+                    node = nullptr;
+                bottom.store(b + 1, ::std::memory_order_relaxed);
+            }
+            return node;
+        }
+
+        /**
+         * @brief Steal the first pushed task (any thread)
+         *
+         * @return task_type* Task or null if empty or lost a race
+         */
+        task_type *steal()
+        {
+            ::std::int64_t t = top.load(::std::memory_order_seq_cst);
+            ::std::int64_t b = bottom.load(::std::memory_order_seq_cst);
+            if (t >= b)
+                return nullptr;
+            ring *r = buffer.load(::std::memory_order_acquire);
+            task_type *node = r->get(t);
+            if (!top.compare_exchange_strong(
+                    t, t + 1,
+                    ::std::memory_order_seq_cst,
+                    ::std::memory_order_relaxed))
+                return nullptr;
+            return node;
+        }
+
+    private:
+        /// @brief Circular array of tasks
+        struct ring
+        {
+            /// @brief Capacity minus one (capacity is a power of two)
+            ::std::size_t mask;
+            /// @brief Slots
+            ::std::unique_ptr<::std::atomic<task_type *>[]> slots;
+
+            /// @brief Create a circular array
+            /// @param capacity Capacity (power of two)
+            explicit ring(::std::size_t capacity)
+                : mask{capacity - 1},
+                  slots{new ::std::atomic<task_type *>[capacity]} {}
+
+            /// @brief Get a slot
+            task_type *get(::std::int64_t index) const noexcept
+            {
+                return slots[index & mask].load(::std::memory_order_relaxed);
+            }
+
+            /// @brief Set a slot
+            void put(::std::int64_t index, task_type *node) noexcept
+            {
+                slots[index & mask].store(node, ::std::memory_order_relaxed);
+            }
+        };
+
+        /**
+         * @brief Double the capacity (owner only)
+         *
+         * @note Old arrays are retired, not deleted,
+         *       since thieves may still be reading them
+         */
+        ring *grow(ring *old, ::std::int64_t t, ::std::int64_t b)
+        {
+            auto bigger = ::std::make_unique<ring>((old->mask + 1) * 2);
+            for (::std::int64_t i = t; i < b; i++)
+                bigger->put(i, old->get(i));
+            ring *result = bigger.get();
+            _rings.push_back(::std::move(bigger));
+            buffer.store(result, ::std::memory_order_release);
+            return result;
+        }
+
+        /// @brief Index of the first task (thieves' end)
+        alignas(64) ::std::atomic<::std::int64_t> top{0};
+        /// @brief Index past the last task (owner's end)
+        alignas(64) ::std::atomic<::std::int64_t> bottom{0};
+        /// @brief All circular arrays ever used (last one is current)
+        ::std::vector<::std::unique_ptr<ring>> _rings = initial_rings();
+        /// @brief Current circular array
+        ::std::atomic<ring *> buffer{_rings.back().get()};
+
+        /// @brief Create the initial circular array
+        static ::std::vector<::std::unique_ptr<ring>> initial_rings()
+        {
+            ::std::vector<::std::unique_ptr<ring>> result;
+            result.push_back(::std::make_unique<ring>(256));
+            return result;
+        }
+    };
+
+    /// @brief Worker thread and its own queue
+    struct worker
+    {
+        /// @brief Own queue
+        work_deque tasks{};
+        /// @brief Thread
+        ::std::thread thread{};
+    };
+
+    /**
+     * @brief Find a task to execute
+     *
+     * @param index Index of the calling worker
+     * @return task_type* Task or null if none found
+     */
+    task_type *find_task(::std::size_t index)
+    {
+        if (task_type *node = _workers[index]->tasks.take())
+            return node;
+        // Note: avoid locking while spinning on an empty queue
+        if (injected_count.load(::std::memory_order_seq_cst) > 0)
+        {
+            ::std::lock_guard<::std::mutex> guard(inject_mutex);
+            if (!_injected.empty())
+            {
+                task_type *node = _injected.front();
+                _injected.pop_front();
+                injected_count.store(_injected.size(), ::std::memory_order_seq_cst);
+                return node;
+            }
+        }
+        for (::std::size_t i = 1; i < _workers.size(); i++)
+            if (task_type *node =
+                    _workers[(index + i) % _workers.size()]->tasks.steal())
+                return node;
+        return nullptr;
+    }
+
+    /**
+     * @brief Worker thread body
+     *
+     * @param index Index of this worker
+     */
+    void run(::std::size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+        waiter idle(_idle);
+        while (true)
+        {
+            task_type *node = nullptr;
+            idle.wait(
+                wake_point,
+                [this, index, &node]()
+                {
+                    node = find_task(index);
+                    return (node != nullptr) ||
+                           stopping.load(::std::memory_order_seq_cst);
+                });
+            if (!node)
+                // Stopping: execute pending tasks first
+                node = find_task(index);
+            if (!node)
+                break;
+            (*node)();
+            delete node;
+        }
+        current_pool = nullptr;
+    }
+
+    /**
+     * @brief Bind a thread to a CPU
+     *
+     * @param thread Thread
+     * @param index CPU index (modulo hardware threads)
+     */
+    static void pin(::std::thread &thread, ::std::size_t index)
+    {
+#if defined(__linux__)
+        unsigned int cpus = ::std::thread::hardware_concurrency();
+        if (cpus == 0)
+            return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        (void)thread;
+        (void)index;
+#endif
+    }
+
+    /// @brief Worker threads
+    ::std::vector<::std::unique_ptr<worker>> _workers{};
+    /// @brief Tasks posted by non-worker threads
+    ::std::deque<task_type *> _injected{};
+    /// @brief Mutex for the shared queue
+    ::std::mutex inject_mutex{};
+    /// @brief Size of the shared queue
+    ::std::atomic<::std::size_t> injected_count{0};
+    /// @brief How idle workers wait for tasks
+    wait_strategy _idle;
+    /// @brief Where idle workers sleep
+    wait_point wake_point{};
+    /// @brief True when the pool is being destroyed
+    ::std::atomic<bool> stopping{false};
+
+    /// @brief Pool owning the calling thread (if any)
+    inline static thread_local thread_pool *current_pool{nullptr};
+    /// @brief Index of the calling worker thread in its pool
+    inline static thread_local ::std::size_t current_index{0};
+};
+
+//------------------------------------------------------------------------------
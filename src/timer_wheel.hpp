@@ -0,0 +1,688 @@
+/**
+ * @file timer_wheel.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Delayed and periodic dispatch of events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "event.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Hierarchical timer wheel
+ *
+ * @note Thread-safe
+ * @note Scheduling and cancelling take constant time.
+ *       Timers are not checked one by one: advance() processes
+ *       whole slots of timers expiring at the same tick.
+ * @note Time does not flow by itself: advance() must be called periodically
+ *       (for example, once per tick or once per frame).
+ *       Delays are relative to the last time given to advance().
+ * @note Timers never expire early. They may expire up to one tick late
+ *       plus the time between calls to advance().
+ */
+class timer_wheel
+{
+public:
+    /// @brief Clock type
+    using clock = ::std::chrono::steady_clock;
+    /// @brief Duration type
+    using duration = clock::duration;
+    /// @brief Time point type
+    using time_point = clock::time_point;
+    /// @brief Task type
+    using task_type = ::std::function<void()>;
+
+    /**
+     * @brief Handler of a scheduled timer
+     *
+     * @note Invalid after the timer is cancelled
+     */
+    class timer_handle
+    {
+        friend class timer_wheel;
+        /// @brief Index of the timer in the pool
+        ::std::uint32_t index{nil};
+        /// @brief Generation of the timer (detects reused pool entries)
+        ::std::uint32_t generation{0};
+
+        /**
+         * @brief Private constructor
+         * @param index Index of the timer in the pool
+         * @param generation Generation of the timer
+         */
+        constexpr timer_handle(::std::uint32_t index, ::std::uint32_t generation) noexcept
+            : index{index}, generation{generation} {}
+
+    public:
+        /**
+         * @brief Check if this handler refers to a timer
+         *
+         * @note True even if the timer has expired
+         *
+         * @return true if valid
+         * @return false otherwise
+         */
+        constexpr bool is_valid() const noexcept
+        {
+            return (index != nil);
+        }
+
+        /// @brief Default constructor
+        constexpr timer_handle() noexcept = default;
+    };
+
+    /**
+     * @brief Run a task at a given time
+     *
+     * @param when Expiration time
+     * @param task Task
+     * @return timer_handle Handler required to cancel
+     */
+    timer_handle schedule_at(time_point when, task_type task)
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        return arm(ticks_ceil(when), 0, ::std::move(task));
+    }
+
+    /**
+     * @brief Run a task after a delay
+     *
+     * @param delay Delay since the last call to advance()
+     * @param task Task
+     * @return timer_handle Handler required to cancel
+     */
+    timer_handle schedule_after(duration delay, task_type task)
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        return arm(ticks_ceil(_now + delay), 0, ::std::move(task));
+    }
+
+    /**
+     * @brief Run a task periodically
+     *
+     * @note First run after one period since the last call to advance()
+     * @note Runs at most once per call to advance(): missed periods
+     *       are skipped
+     *
+     * @param period Period (at least one tick)
+     * @param task Task
+     * @return timer_handle Handler required to cancel
+     */
+    timer_handle schedule_every(duration period, task_type task)
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        ::std::uint64_t ticks = ::std::max<::std::uint64_t>(
+            1, (period + _resolution - duration(1)) / _resolution);
+        return arm(ticks_ceil(_now + period), ticks, ::std::move(task));
+    }
+
+    /**
+     * @brief Dispatch an event at a given time
+     *
+     * @note Event data is copied
+     * @warning @p target must exceed the lifetime of the timer
+     *
+     * @tparam Args Callback argument types
+     * @param when Expiration time
+     * @param target Event to dispatch
+     * @param args Event data
+     * @return timer_handle Handler required to cancel
+     */
+    template <class... Args>
+    timer_handle dispatch_at(
+        time_point when,
+        event<Args...> &target,
+        const ::std::type_identity_t<Args> &...args)
+    {
+        return schedule_at(when, dispatcher(target, args...));
+    }
+
+    /**
+     * @brief Dispatch an event after a delay
+     *
+     * @note Event data is copied
+     * @warning @p target must exceed the lifetime of the timer
+     *
+     * @tparam Args Callback argument types
+     * @param delay Delay since the last call to advance()
+     * @param target Event to dispatch
+     * @param args Event data
+     * @return timer_handle Handler required to cancel
+     */
+    template <class... Args>
+    timer_handle dispatch_after(
+        duration delay,
+        event<Args...> &target,
+        const ::std::type_identity_t<Args> &...args)
+    {
+        return schedule_after(delay, dispatcher(target, args...));
+    }
+
+    /**
+     * @brief Dispatch an event periodically
+     *
+     * @note Event data is copied
+     * @warning @p target must exceed the lifetime of the timer
+     *
+     * @tparam Args Callback argument types
+     * @param period Period (at least one tick)
+     * @param target Event to dispatch
+     * @param args Event data
+     * @return timer_handle Handler required to cancel
+     */
+    template <class... Args>
+    timer_handle dispatch_every(
+        duration period,
+        event<Args...> &target,
+        const ::std::type_identity_t<Args> &...args)
+    {
+        return schedule_every(period, dispatcher(target, args...));
+    }
+
+    /**
+     * @brief Cancel a timer
+     *
+     * @note Constant time
+     * @note A timer cancelled by another thread while expiring
+     *       may still run once
+     *
+     * @param h Handler returned when scheduling
+     * @return true if cancelled
+     * @return false if already expired or cancelled
+     */
+    bool cancel(timer_handle &h)
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        bool result = false;
+        if (owns(h))
+        {
+            node &target = _nodes[h.index];
+            if (target.state == node_state::armed)
+            {
+                unlink(h.index);
+                release(h.index);
+                result = true;
+            }
+            else if ((target.state == node_state::expiring) && !target.cancelled)
+            {
+                target.cancelled = true;
+                result = true;
+            }
+        }
+        h = timer_handle();
+        return result;
+    }
+
+    /**
+     * @brief Check if a timer is pending
+     *
+     * @param h Handler returned when scheduling
+     * @return true if it has not expired yet (or it is periodic)
+     *         and it has not been cancelled
+     * @return false otherwise
+     */
+    bool is_armed(const timer_handle &h) const
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        return owns(h) && !_nodes[h.index].cancelled;
+    }
+
+    /**
+     * @brief Get the number of pending timers
+     *
+     * @return ::std::size_t Count of armed timers
+     */
+    ::std::size_t size() const
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        return _armed;
+    }
+
+    /**
+     * @brief Run all tasks expired up to a given time
+     *
+     * @note Tasks are run in the calling thread, in expiration order
+     *       (tick by tick), without locks.
+     *       They may schedule and cancel timers.
+     * @warning Must not be called from a task
+     *
+     * @param now Current time
+     * @return ::std::size_t Count of tasks run
+     */
+    ::std::size_t advance(time_point now = clock::now())
+    {
+        ::std::lock_guard<::std::mutex> advance_guard(advance_mutex);
+        {
+            ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+            if (now > _now)
+                _now = now;
+            collect(ticks_floor(_now));
+        }
+
+        ::std::size_t count = 0;
+        try
+        {
+            for (auto &[index, task] : _expired)
+            {
+                {
+                    ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+                    if (_nodes[index].cancelled)
+                        continue;
+                }
+                task();
+                count++;
+            }
+        }
+        catch (...)
+        {
+            rearm();
+            throw;
+        }
+        rearm();
+        return count;
+    }
+
+    /**
+     * @brief Get the current time of this wheel
+     *
+     * @return time_point Last time given to advance() (or the start time)
+     */
+    time_point now() const
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        return _now;
+    }
+
+    /**
+     * @brief Get the duration of a tick
+     *
+     * @return duration Resolution of the timers
+     */
+    duration resolution() const noexcept
+    {
+        return _resolution;
+    }
+
+    /**
+     * @brief Create a timer wheel
+     *
+     * @param resolution Duration of a tick
+     * @param start Start time
+     */
+    explicit timer_wheel(
+        duration resolution = ::std::chrono::milliseconds(1),
+        time_point start = clock::now())
+        : _resolution{(resolution > duration::zero()) ? resolution : duration(1)},
+          _start{start},
+          _now{start}
+    {
+        for (auto &level : _slots)
+            level.fill(nil);
+    }
+
+    /// @brief Copy constructor (deleted)
+    timer_wheel(const timer_wheel &) = delete;
+    /// @brief Copy-assignment (deleted)
+    timer_wheel &operator=(const timer_wheel &) = delete;
+
+private:
+    /// @brief No index
+    static constexpr ::std::uint32_t nil = ::std::numeric_limits<::std::uint32_t>::max();
+    /// @brief Bits of the tick count per level
+    static constexpr unsigned int level_bits = 8;
+    /// @brief Count of slots per level
+    static constexpr ::std::size_t slot_count = ::std::size_t{1} << level_bits;
+    /// @brief Count of levels
+    static constexpr unsigned int level_count = 4;
+    /// @brief Ticks covered by all levels
+    static constexpr ::std::uint64_t max_delta =
+        ::std::uint64_t{1} << (level_bits * level_count);
+
+    /// @brief Lifecycle of a pooled timer
+    enum class node_state : ::std::uint8_t
+    {
+        free,
+        armed,
+        expiring
+    };
+
+    /// @brief Pooled timer
+    struct node
+    {
+        /// @brief Task (moved out while expiring)
+        task_type task{};
+        /// @brief Expiration tick
+        ::std::uint64_t expiry{0};
+        /// @brief Period in ticks (zero if not periodic)
+        ::std::uint64_t period{0};
+        /// @brief Previous timer in the same slot
+        ::std::uint32_t prev{nil};
+        /// @brief Next timer in the same slot (or in the free list)
+        ::std::uint32_t next{nil};
+        /// @brief Incremented when returned to the pool
+        ::std::uint32_t generation{0};
+        /// @brief Slot holding this timer
+        ::std::uint16_t slot{0};
+        /// @brief Level holding this timer
+        ::std::uint8_t level{0};
+        /// @brief Lifecycle
+        node_state state{node_state::free};
+        /// @brief True if cancelled while expiring
+        bool cancelled{false};
+    };
+
+    /**
+     * @brief Create a task dispatching an event
+     *
+     * @tparam Args Callback argument types
+     * @param target Event
+     * @param args Event data
+     * @return task_type Task
+     */
+    template <class... Args>
+    static task_type dispatcher(
+        event<Args...> &target,
+        const ::std::type_identity_t<Args> &...args)
+    {
+        static_assert(
+            (... && ::std::is_copy_constructible_v<::std::decay_t<Args>>),
+            "Event data must be copyable");
+        return [&target, payload = ::std::tuple<::std::decay_t<Args>...>(args...)]()
+        {
+            ::std::apply(target, payload);
+        };
+    }
+
+    /**
+     * @brief Convert a time point to ticks, rounding up
+     *
+     * @param when Time point
+     * @return ::std::uint64_t Tick
+     */
+    ::std::uint64_t ticks_ceil(time_point when) const noexcept
+    {
+        if (when <= _start)
+            return 0;
+        return static_cast<::std::uint64_t>(
+            (when - _start + _resolution - duration(1)) / _resolution);
+    }
+
+    /**
+     * @brief Convert a time point to ticks, rounding down
+     *
+     * @param when Time point
+     * @return ::std::uint64_t Tick
+     */
+    ::std::uint64_t ticks_floor(time_point when) const noexcept
+    {
+        if (when <= _start)
+            return 0;
+        return static_cast<::std::uint64_t>((when - _start) / _resolution);
+    }
+
+    /**
+     * @brief Check if a handler refers to a timer of this wheel
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param h Handler
+     * @return true if the timer is armed or expiring
+     * @return false otherwise
+     */
+    bool owns(const timer_handle &h) const noexcept
+    {
+        return (h.index < _nodes.size()) &&
+               (_nodes[h.index].generation == h.generation) &&
+               (_nodes[h.index].state != node_state::free);
+    }
+
+    /**
+     * @brief Take a timer from the pool and insert it
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param expiry Expiration tick
+     * @param period Period in ticks (zero if not periodic)
+     * @param task Task
+     * @return timer_handle Handler
+     */
+    timer_handle arm(::std::uint64_t expiry, ::std::uint64_t period, task_type task)
+    {
+        ::std::uint32_t index = _free;
+        if (index == nil)
+        {
+            index = static_cast<::std::uint32_t>(_nodes.size());
+            _nodes.emplace_back();
+        }
+        else
+            _free = _nodes[index].next;
+        node &target = _nodes[index];
+        target.task = ::std::move(task);
+        target.expiry = expiry;
+        target.period = period;
+        target.cancelled = false;
+        insert(index);
+        return timer_handle(index, target.generation);
+    }
+
+    /**
+     * @brief Return a timer to the pool
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param index Timer (not linked)
+     */
+    void release(::std::uint32_t index) noexcept
+    {
+        node &target = _nodes[index];
+        target.task = nullptr;
+        target.state = node_state::free;
+        target.generation++;
+        target.next = _free;
+        _free = index;
+    }
+
+    /**
+     * @brief Link a timer into the slot for its expiration tick
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param index Timer
+     */
+    void insert(::std::uint32_t index) noexcept
+    {
+        node &target = _nodes[index];
+        ::std::uint64_t expiry = ::std::max(target.expiry, _current);
+        ::std::uint64_t delta = expiry - _current;
+        if (delta >= max_delta)
+        {
+            // Beyond the last level: parked there until cascaded again
+            delta = max_delta - 1;
+            expiry = _current + delta;
+        }
+        unsigned int level = 0;
+        while ((level + 1 < level_count) &&
+               (delta >= (::std::uint64_t{1} << (level_bits * (level + 1)))))
+            level++;
+        auto slot = static_cast<::std::uint16_t>(
+            (expiry >> (level_bits * level)) & (slot_count - 1));
+
+        ::std::uint32_t &head = _slots[level][slot];
+        target.prev = nil;
+        target.next = head;
+        if (head != nil)
+            _nodes[head].prev = index;
+        head = index;
+        target.level = static_cast<::std::uint8_t>(level);
+        target.slot = slot;
+        target.state = node_state::armed;
+        _armed++;
+    }
+
+    /**
+     * @brief Unlink a timer from its slot
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param index Timer (armed)
+     */
+    void unlink(::std::uint32_t index) noexcept
+    {
+        node &target = _nodes[index];
+        if (target.prev != nil)
+            _nodes[target.prev].next = target.next;
+        else
+            _slots[target.level][target.slot] = target.next;
+        if (target.next != nil)
+            _nodes[target.next].prev = target.prev;
+        _armed--;
+    }
+
+    /**
+     * @brief Detach all timers in a slot
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param level Level
+     * @param slot Slot
+     * @return ::std::uint32_t First timer in the detached list
+     */
+    ::std::uint32_t detach(unsigned int level, ::std::size_t slot) noexcept
+    {
+        ::std::uint32_t head = _slots[level][slot];
+        _slots[level][slot] = nil;
+        for (::std::uint32_t index = head; index != nil; index = _nodes[index].next)
+            _armed--;
+        return head;
+    }
+
+    /**
+     * @brief Move expired timers to the list of expired tasks
+     *
+     * @note Must be called with the wheel mutex locked
+     *
+     * @param target Last tick to process
+     */
+    void collect(::std::uint64_t target)
+    {
+        while (_current <= target)
+        {
+            if (_armed == 0)
+            {
+                // Nothing to expire: jump
+                _current = target + 1;
+                break;
+            }
+            ::std::size_t slot = _current & (slot_count - 1);
+            if (slot == 0)
+                cascade();
+            ::std::uint32_t index = detach(0, slot);
+            while (index != nil)
+            {
+                node &expired = _nodes[index];
+                ::std::uint32_t next = expired.next;
+                expired.state = node_state::expiring;
+                _expired.emplace_back(index, ::std::move(expired.task));
+                index = next;
+            }
+            _current++;
+        }
+    }
+
+    /**
+     * @brief Move timers from higher levels to lower levels
+     *
+     * @note Must be called with the wheel mutex locked,
+     *       when the current tick is a multiple of the slot count
+     */
+    void cascade() noexcept
+    {
+        for (unsigned int level = 1; level < level_count; level++)
+        {
+            ::std::size_t slot =
+                (_current >> (level_bits * level)) & (slot_count - 1);
+            ::std::uint32_t index = detach(level, slot);
+            while (index != nil)
+            {
+                ::std::uint32_t next = _nodes[index].next;
+                insert(index);
+                index = next;
+            }
+            if (slot != 0)
+                break;
+        }
+    }
+
+    /**
+     * @brief Rearm periodic timers and release the rest after expiration
+     *
+     */
+    void rearm() noexcept
+    {
+        ::std::lock_guard<::std::mutex> guard(wheel_mutex);
+        for (auto &[index, task] : _expired)
+        {
+            node &target = _nodes[index];
+            if (target.period && !target.cancelled)
+            {
+                target.task = ::std::move(task);
+                target.expiry += target.period;
+                if (target.expiry < _current)
+                    // Skip missed periods, keeping the phase
+                    target.expiry +=
+                        (_current - target.expiry + target.period - 1) /
+                        target.period * target.period;
+                insert(index);
+            }
+            else
+                release(index);
+        }
+        _expired.clear();
+    }
+
+    /// @brief Duration of a tick
+    duration _resolution;
+    /// @brief Time of tick zero
+    time_point _start;
+    /// @brief Last time given to advance()
+    time_point _now;
+    /// @brief Next tick to process
+    ::std::uint64_t _current{0};
+    /// @brief Count of armed timers
+    ::std::size_t _armed{0};
+    /// @brief Pool of timers
+    ::std::vector<node> _nodes{};
+    /// @brief First free timer in the pool
+    ::std::uint32_t _free{nil};
+    /// @brief First timer in each slot of each level
+    ::std::array<::std::array<::std::uint32_t, slot_count>, level_count> _slots{};
+    /// @brief Expired timers and their tasks (being run)
+    ::std::vector<::std::pair<::std::uint32_t, task_type>> _expired{};
+    /// @brief Mutex for the wheel
+    mutable ::std::mutex wheel_mutex{};
+    /// @brief Mutex for advance()
+    ::std::mutex advance_mutex{};
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,290 @@
+/**
+ * @file wait_strategy.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Waiting for another thread to make progress
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief How a thread waits for another thread to make progress
+ *
+ */
+enum class wait_strategy
+{
+    /// @brief Poll continuously (lowest latency, burns a core)
+    busy_spin,
+    /// @brief Poll, yielding the processor between attempts
+    yield,
+    /// @brief Sleep until notified (highest latency, no CPU cost)
+    block,
+    /// @brief Spin for a while, then yield for a while, then sleep.
+    ///        Spin time adapts to observed waiting times.
+    adaptive
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Point where threads sleep until notified
+ *
+ * @note Thread-safe
+ * @note Notifying is cheap when no thread is sleeping.
+ */
+class wait_point
+{
+public:
+    /**
+     * @brief Wake all sleeping threads (if any)
+     *
+     * @note Call after making progress visible to waiting threads
+     *       (sequentially-consistent atomic store)
+     */
+    void notify() noexcept
+    {
+        if (sleepers.load(::std::memory_order_seq_cst) > 0)
+        {
+            epoch.fetch_add(1, ::std::memory_order_seq_cst);
+            epoch.notify_all();
+        }
+    }
+
+    /**
+     * @brief Wake one sleeping thread (if any)
+     *
+     * @note Call after making progress visible to waiting threads
+     *       (sequentially-consistent atomic store)
+     */
+    void notify_one() noexcept
+    {
+        if (sleepers.load(::std::memory_order_seq_cst) > 0)
+        {
+            epoch.fetch_add(1, ::std::memory_order_seq_cst);
+            epoch.notify_one();
+        }
+    }
+
+private:
+    friend class waiter;
+    /// @brief Incremented to wake sleeping threads
+    ::std::atomic<::std::uint32_t> epoch{0};
+    /// @brief Count of sleeping threads
+    ::std::atomic<int> sleepers{0};
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Waits for a condition according to a wait strategy
+ *
+ * @note Not thread-safe: each waiting thread should have its own instance
+ */
+class waiter
+{
+public:
+    /**
+     * @brief Create a waiter
+     *
+     * @param strategy Wait strategy
+     */
+    explicit waiter(wait_strategy strategy = wait_strategy::block) noexcept
+        : _strategy{strategy} {}
+
+    /**
+     * @brief Wait until a condition is met
+     *
+     * @note @p ready must read the progress of other threads
+     *       using sequentially-consistent atomic loads,
+     *       and those threads must call wait_point::notify()
+     *       after making progress.
+     * @note @p ready may be called any number of times.
+     *       Waiting stops as soon as it returns true,
+     *       and it is not called again after that,
+     *       so it may take the awaited resource itself.
+     *
+     * @tparam Ready Condition type
+     * @param point Where to sleep (wait_strategy::block only)
+     * @param ready Condition: returns true to stop waiting
+     */
+    template <class Ready>
+    void wait(wait_point &point, Ready &&ready)
+    {
+        switch (_strategy)
+        {
+        case wait_strategy::busy_spin:
+            while (!ready())
+                cpu_relax();
+            break;
+        case wait_strategy::yield:
+            while (!ready())
+                ::std::this_thread::yield();
+            break;
+        case wait_strategy::adaptive:
+            adaptive_wait(point, ready);
+            break;
+        default:
+            park(point, ready);
+        }
+    }
+
+    /**
+     * @brief Get the wait strategy
+     *
+     * @return wait_strategy Wait strategy
+     */
+    wait_strategy strategy() const noexcept
+    {
+        return _strategy;
+    }
+
+    /**
+     * @brief Hint the processor that the calling thread is spinning
+     *
+     */
+    static void cpu_relax() noexcept
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    /**
+     * @brief Get the current spin time (wait_strategy::adaptive only)
+     *
+     * @return ::std::chrono::nanoseconds Spin time
+     */
+    ::std::chrono::nanoseconds spin_time() const noexcept
+    {
+        return _spin_time;
+    }
+
+    /**
+     * @brief Account for a wait (wait_strategy::adaptive only)
+     *
+     * @note Called by wait() with the time it took.
+     *       The spin time becomes twice the exponential moving
+     *       average of the waiting time (weight 1/8), or zero while
+     *       that average exceeds max_spin_time.
+     *       Long waits are capped, so spinning resumes quickly
+     *       when events start arriving at a steady pace.
+     *
+     * @param waited Waiting time
+     */
+    void adapt(::std::chrono::nanoseconds waited) noexcept
+    {
+        waited = ::std::min<::std::chrono::nanoseconds>(waited, 4 * max_spin_time);
+        _average_wait += (waited - _average_wait) / 8;
+        _spin_time = (_average_wait <= max_spin_time)
+                         ? ::std::min(2 * _average_wait, max_spin_time)
+                         : ::std::chrono::nanoseconds::zero();
+    }
+
+    /// @brief Maximum spin time (wait_strategy::adaptive)
+    static constexpr ::std::chrono::nanoseconds max_spin_time{50'000};
+    /// @brief Count of yields before sleeping (wait_strategy::adaptive)
+    static constexpr int yield_limit = 16;
+
+private:
+    /// @brief Spin iterations between clock readings
+    static constexpr int clock_period = 32;
+
+    /**
+     * @brief Sleep until a condition is met
+     *
+     * @tparam Ready Condition type
+     * @param point Where to sleep
+     * @param ready Condition
+     */
+    template <class Ready>
+    static void park(wait_point &point, Ready &ready)
+    {
+        if (ready())
+            return;
+        while (true)
+        {
+            ::std::uint32_t ticket = point.epoch.load(::std::memory_order_seq_cst);
+            point.sleepers.fetch_add(1, ::std::memory_order_seq_cst);
+            if (ready())
+            {
+                point.sleepers.fetch_sub(1, ::std::memory_order_seq_cst);
+                return;
+            }
+            point.epoch.wait(ticket, ::std::memory_order_seq_cst);
+            point.sleepers.fetch_sub(1, ::std::memory_order_seq_cst);
+            if (ready())
+                return;
+        }
+    }
+
+    /**
+     * @brief Spin, then yield, then sleep until a condition is met
+     *
+     * @note The spin time is twice the average waiting time
+     *       (see adapt()), so a steady flow of events is caught
+     *       while spinning. Spinning is skipped while the average
+     *       waiting time exceeds max_spin_time, since it would be wasted.
+     *
+     * @tparam Ready Condition type
+     * @param point Where to sleep
+     * @param ready Condition
+     */
+    template <class Ready>
+    void adaptive_wait(wait_point &point, Ready &ready)
+    {
+        if (ready())
+            return;
+        auto start = ::std::chrono::steady_clock::now();
+        auto elapsed = ::std::chrono::nanoseconds::zero();
+        bool done = false;
+
+        // Spin
+        while (!done && (elapsed < _spin_time))
+        {
+            for (int i = 0; !done && (i < clock_period); i++)
+            {
+                cpu_relax();
+                done = ready();
+            }
+            elapsed = ::std::chrono::steady_clock::now() - start;
+        }
+
+        // Yield
+        for (int i = 0; !done && (i < yield_limit); i++)
+        {
+            ::std::this_thread::yield();
+            done = ready();
+        }
+
+        // Sleep
+        if (!done)
+            park(point, ready);
+
+        adapt(::std::chrono::steady_clock::now() - start);
+    }
+
+    /// @brief Wait strategy
+    wait_strategy _strategy;
+    /// @brief Current spin time (adaptive only)
+    ::std::chrono::nanoseconds _spin_time{max_spin_time};
+    /// @brief Average waiting time (adaptive only)
+    ::std::chrono::nanoseconds _average_wait{max_spin_time / 2};
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,610 @@
+/**
+ * @file window.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Windowed aggregation of event data
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "combinators.hpp"
+#include "event.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Aggregate computed over windows of values (a monoid)
+ *
+ * @note combine() must be associative and identity() must be its
+ *       neutral element. combine() need not be commutative:
+ *       older states are always given first.
+ */
+template <class A>
+concept window_aggregate = requires(
+    const typename A::value_type &value,
+    const typename A::state_type &state) {
+    { A::identity() } -> ::std::convertible_to<typename A::state_type>;
+    { A::lift(value) } -> ::std::convertible_to<typename A::state_type>;
+    { A::combine(state, state) } -> ::std::convertible_to<typename A::state_type>;
+    { A::lower(state) } -> ::std::convertible_to<typename A::result_type>;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Count of values
+ *
+ * @tparam T Value type
+ */
+template <class T>
+struct count_aggregate
+{
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Partial aggregate type
+    using state_type = ::std::size_t;
+    /// @brief Result type
+    using result_type = ::std::size_t;
+
+    /// @brief Empty partial aggregate
+    static state_type identity() noexcept { return 0; }
+    /// @brief Partial aggregate of a single value
+    static state_type lift(const T &) noexcept { return 1; }
+    /// @brief Partial aggregate of two partial aggregates
+    static state_type combine(state_type a, state_type b) noexcept { return a + b; }
+    /// @brief Result of a partial aggregate
+    static result_type lower(state_type s) noexcept { return s; }
+};
+
+/**
+ * @brief Sum of values
+ *
+ * @tparam T Value type
+ */
+template <class T>
+struct sum_aggregate
+{
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Partial aggregate type
+    using state_type = T;
+    /// @brief Result type
+    using result_type = T;
+
+    /// @brief Empty partial aggregate
+    static state_type identity() { return T{}; }
+    /// @brief Partial aggregate of a single value
+    static state_type lift(const T &value) { return value; }
+    /// @brief Partial aggregate of two partial aggregates
+    static state_type combine(const T &a, const T &b) { return a + b; }
+    /// @brief Result of a partial aggregate
+    static result_type lower(const T &s) { return s; }
+};
+
+/**
+ * @brief Minimum value
+ *
+ * @note ::std::numeric_limits<T>::max() if there are no values
+ *
+ * @tparam T Value type
+ */
+template <class T>
+struct min_aggregate
+{
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Partial aggregate type
+    using state_type = T;
+    /// @brief Result type
+    using result_type = T;
+
+    /// @brief Empty partial aggregate
+    static state_type identity() { return ::std::numeric_limits<T>::max(); }
+    /// @brief Partial aggregate of a single value
+    static state_type lift(const T &value) { return value; }
+    /// @brief Partial aggregate of two partial aggregates
+    static state_type combine(const T &a, const T &b) { return (b < a) ? b : a; }
+    /// @brief Result of a partial aggregate
+    static result_type lower(const T &s) { return s; }
+};
+
+/**
+ * @brief Maximum value
+ *
+ * @note ::std::numeric_limits<T>::lowest() if there are no values
+ *
+ * @tparam T Value type
+ */
+template <class T>
+struct max_aggregate
+{
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Partial aggregate type
+    using state_type = T;
+    /// @brief Result type
+    using result_type = T;
+
+    /// @brief Empty partial aggregate
+    static state_type identity() { return ::std::numeric_limits<T>::lowest(); }
+    /// @brief Partial aggregate of a single value
+    static state_type lift(const T &value) { return value; }
+    /// @brief Partial aggregate of two partial aggregates
+    static state_type combine(const T &a, const T &b) { return (a < b) ? b : a; }
+    /// @brief Result of a partial aggregate
+    static result_type lower(const T &s) { return s; }
+};
+
+/**
+ * @brief Arithmetic mean of values
+ *
+ * @note Zero if there are no values
+ *
+ * @tparam T Value type
+ */
+template <class T>
+struct mean_aggregate
+{
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Partial aggregate type: sum and count
+    using state_type = ::std::pair<double, ::std::size_t>;
+    /// @brief Result type
+    using result_type = double;
+
+    /// @brief Empty partial aggregate
+    static state_type identity() noexcept { return {0.0, 0}; }
+    /// @brief Partial aggregate of a single value
+    static state_type lift(const T &value) { return {static_cast<double>(value), 1}; }
+    /// @brief Partial aggregate of two partial aggregates
+    static state_type combine(const state_type &a, const state_type &b) noexcept
+    {
+        return {a.first + b.first, a.second + b.second};
+    }
+    /// @brief Result of a partial aggregate
+    static result_type lower(const state_type &s) noexcept
+    {
+        return s.second ? (s.first / static_cast<double>(s.second)) : 0.0;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Aggregate of values in consecutive, non-overlapping windows
+ *
+ * @note The aggregate of a window is dispatched when it ends,
+ *       if the window has any value.
+ *       The end of a window is noticed when a value arrives after it
+ *       or when advance() is called.
+ * @note Constant time per value
+ * @note The downstream event is dispatched with the lock held
+ *
+ * @tparam Aggregate Aggregate type (see window_aggregate)
+ * @tparam Clock Clock type
+ * @tparam Lock Lock type (see combine_latest)
+ */
+template <
+    window_aggregate Aggregate,
+    class Clock = ::std::chrono::steady_clock,
+    class Lock = ::std::mutex>
+class tumbling_window
+{
+public:
+    /// @brief This type
+    using type = tumbling_window<Aggregate, Clock, Lock>;
+    /// @brief Value type
+    using value_type = typename Aggregate::value_type;
+    /// @brief Result type
+    using result_type = typename Aggregate::result_type;
+    /// @brief Downstream event type
+    using event_type = event<const result_type &>;
+
+    /**
+     * @brief Subscribe to a source
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Source Event or observable
+     * @param downstream Downstream event
+     * @param source Source
+     * @param width Duration of each window
+     */
+    template <class Source>
+    tumbling_window(
+        event_type &downstream,
+        Source &source,
+        typename Clock::duration width)
+        : _downstream{downstream},
+          _width{width},
+          _link{source, [this](const value_type &value)
+                { receive(value); }} {}
+
+    /**
+     * @brief Dispatch the aggregate of the current window if it has ended
+     *
+     * @param now Current time
+     */
+    void advance(typename Clock::time_point now = Clock::now())
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        close(now);
+    }
+
+    /// @brief Copy constructor (deleted)
+    tumbling_window(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Aggregate a value
+     *
+     * @param value Value
+     */
+    void receive(const value_type &value)
+    {
+        auto now = Clock::now();
+        ::std::lock_guard<Lock> guard(_lock);
+        close(now);
+        if (_empty)
+        {
+            if (now >= _end)
+                // Windows are aligned to the construction time
+                _end += ((now - _end) / _width + 1) * _width;
+            _empty = false;
+        }
+        _state = Aggregate::combine(_state, Aggregate::lift(value));
+    }
+
+    /**
+     * @brief Dispatch the aggregate of the current window if it has ended
+     *
+     * @note Must be called with the lock held
+     *
+     * @param now Current time
+     */
+    void close(typename Clock::time_point now)
+    {
+        if (_empty || (now < _end))
+            return;
+        _downstream(Aggregate::lower(_state));
+        _state = Aggregate::identity();
+        _empty = true;
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Duration of each window
+    typename Clock::duration _width;
+    /// @brief End of the current window
+    typename Clock::time_point _end{Clock::now()};
+    /// @brief Aggregate of the current window
+    typename Aggregate::state_type _state{Aggregate::identity()};
+    /// @brief True if the current window has no values
+    bool _empty{true};
+    /// @brief Lock
+    Lock _lock{};
+    /// @brief Subscription (destroyed first)
+    value_subscription<value_type> _link;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Aggregate of the values received during the last period of time
+ *
+ * @note The aggregate is dispatched when a value arrives
+ *       and when advance() expires any value.
+ * @note Two-stack algorithm: constant amortized time per value,
+ *       for any associative aggregate (no inverse required).
+ *       Memory is proportional to the count of values in the window.
+ * @note The downstream event is dispatched with the lock held
+ *
+ * @tparam Aggregate Aggregate type (see window_aggregate)
+ * @tparam Clock Clock type
+ * @tparam Lock Lock type (see combine_latest)
+ */
+template <
+    window_aggregate Aggregate,
+    class Clock = ::std::chrono::steady_clock,
+    class Lock = ::std::mutex>
+class sliding_window
+{
+public:
+    /// @brief This type
+    using type = sliding_window<Aggregate, Clock, Lock>;
+    /// @brief Value type
+    using value_type = typename Aggregate::value_type;
+    /// @brief Result type
+    using result_type = typename Aggregate::result_type;
+    /// @brief Downstream event type
+    using event_type = event<const result_type &>;
+
+    /**
+     * @brief Subscribe to a source
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Source Event or observable
+     * @param downstream Downstream event
+     * @param source Source
+     * @param width Duration of the window
+     */
+    template <class Source>
+    sliding_window(
+        event_type &downstream,
+        Source &source,
+        typename Clock::duration width)
+        : _downstream{downstream},
+          _width{width},
+          _link{source, [this](const value_type &value)
+                { receive(value); }} {}
+
+    /**
+     * @brief Expire old values
+     *
+     * @note The aggregate is dispatched if any value expired
+     *
+     * @param now Current time
+     */
+    void advance(typename Clock::time_point now = Clock::now())
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        if (evict(now))
+            _downstream(Aggregate::lower(aggregate()));
+    }
+
+    /**
+     * @brief Get the count of values in the window
+     *
+     * @return ::std::size_t Count of values
+     */
+    ::std::size_t size() const
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        return _front.size() + _back.size();
+    }
+
+    /// @brief Copy constructor (deleted)
+    sliding_window(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /// @brief Value in the window
+    struct entry
+    {
+        /// @brief Arrival time
+        typename Clock::time_point time;
+        /// @brief Partial aggregate of this value
+        typename Aggregate::state_type value;
+        /// @brief Partial aggregate of this value and newer values
+        ///        in the same stack (front stack only)
+        typename Aggregate::state_type suffix;
+    };
+
+    /**
+     * @brief Aggregate a value
+     *
+     * @param value Value
+     */
+    void receive(const value_type &value)
+    {
+        auto now = Clock::now();
+        ::std::lock_guard<Lock> guard(_lock);
+        evict(now);
+        auto lifted = Aggregate::lift(value);
+        _back_state = Aggregate::combine(_back_state, lifted);
+        _back.push_back({now, ::std::move(lifted), Aggregate::identity()});
+        _downstream(Aggregate::lower(aggregate()));
+    }
+
+    /**
+     * @brief Aggregate of all values in the window
+     *
+     * @note Must be called with the lock held
+     *
+     * @return Aggregate::state_type Partial aggregate
+     */
+    typename Aggregate::state_type aggregate() const
+    {
+        if (_front.empty())
+            return _back_state;
+        return Aggregate::combine(_front.back().suffix, _back_state);
+    }
+
+    /**
+     * @brief Remove values older than the window
+     *
+     * @note Must be called with the lock held
+     *
+     * @param now Current time
+     * @return true if any value was removed
+     * @return false otherwise
+     */
+    bool evict(typename Clock::time_point now)
+    {
+        bool evicted = false;
+        while (true)
+        {
+            if (_front.empty())
+            {
+                if (_back.empty() || (now - _back.front().time < _width))
+                    break;
+                flip();
+            }
+            if (now - _front.back().time < _width)
+                break;
+            _front.pop_back();
+            evicted = true;
+        }
+        return evicted;
+    }
+
+    /**
+     * @brief Move all values from the back stack to the front stack
+     *
+     * @note Must be called with the lock held.
+     *       The oldest value ends on top of the front stack.
+     *       Both vectors keep their capacity.
+     */
+    void flip()
+    {
+        auto suffix = Aggregate::identity();
+        for (auto it = _back.rbegin(); it != _back.rend(); ++it)
+        {
+            suffix = Aggregate::combine(it->value, suffix);
+            it->suffix = suffix;
+            _front.push_back(::std::move(*it));
+        }
+        _back.clear();
+        _back_state = Aggregate::identity();
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Duration of the window
+    typename Clock::duration _width;
+    /// @brief Older values, the oldest on top
+    ::std::vector<entry> _front{};
+    /// @brief Newer values, the newest on top
+    ::std::vector<entry> _back{};
+    /// @brief Partial aggregate of the back stack
+    typename Aggregate::state_type _back_state{Aggregate::identity()};
+    /// @brief Lock
+    mutable Lock _lock{};
+    /// @brief Subscription (destroyed first)
+    value_subscription<value_type> _link;
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Aggregate of values arriving close in time
+ *
+ * @note A session ends when no value arrives during a gap of time.
+ *       Then, the aggregate of the session is dispatched.
+ *       The end of a session is noticed when a value arrives after it
+ *       or when advance() is called.
+ * @note Constant time per value
+ * @note The downstream event is dispatched with the lock held
+ *
+ * @tparam Aggregate Aggregate type (see window_aggregate)
+ * @tparam Clock Clock type
+ * @tparam Lock Lock type (see combine_latest)
+ */
+template <
+    window_aggregate Aggregate,
+    class Clock = ::std::chrono::steady_clock,
+    class Lock = ::std::mutex>
+class session_window
+{
+public:
+    /// @brief This type
+    using type = session_window<Aggregate, Clock, Lock>;
+    /// @brief Value type
+    using value_type = typename Aggregate::value_type;
+    /// @brief Result type
+    using result_type = typename Aggregate::result_type;
+    /// @brief Downstream event type
+    using event_type = event<const result_type &>;
+
+    /**
+     * @brief Subscribe to a source
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam Source Event or observable
+     * @param downstream Downstream event
+     * @param source Source
+     * @param gap Inactivity ending a session
+     */
+    template <class Source>
+    session_window(
+        event_type &downstream,
+        Source &source,
+        typename Clock::duration gap)
+        : _downstream{downstream},
+          _gap{gap},
+          _link{source, [this](const value_type &value)
+                { receive(value); }} {}
+
+    /**
+     * @brief Dispatch the aggregate of the current session if it has ended
+     *
+     * @param now Current time
+     */
+    void advance(typename Clock::time_point now = Clock::now())
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        close(now);
+    }
+
+    /// @brief Copy constructor (deleted)
+    session_window(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Aggregate a value
+     *
+     * @param value Value
+     */
+    void receive(const value_type &value)
+    {
+        auto now = Clock::now();
+        ::std::lock_guard<Lock> guard(_lock);
+        close(now);
+        _state = Aggregate::combine(_state, Aggregate::lift(value));
+        _last = now;
+        _active = true;
+    }
+
+    /**
+     * @brief Dispatch the aggregate of the current session if it has ended
+     *
+     * @note Must be called with the lock held
+     *
+     * @param now Current time
+     */
+    void close(typename Clock::time_point now)
+    {
+        if (!_active || (now - _last < _gap))
+            return;
+        _downstream(Aggregate::lower(_state));
+        _state = Aggregate::identity();
+        _active = false;
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Inactivity ending a session
+    typename Clock::duration _gap;
+    /// @brief Arrival time of the last value
+    typename Clock::time_point _last{};
+    /// @brief Aggregate of the current session
+    typename Aggregate::state_type _state{Aggregate::identity()};
+    /// @brief True if a session is in progress
+    bool _active{false};
+    /// @brief Lock
+    Lock _lock{};
+    /// @brief Subscription (destroyed first)
+    value_subscription<value_type> _link;
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,436 @@
+/**
+ * @file window_join.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Keyed join of two events within a window of time
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "combinators.hpp"
+#include "event.hpp"
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief How matched values are joined
+ *
+ */
+enum class join_mode
+{
+    /// @brief Every value matches all values having the same key
+    ///        in the other source (within the window)
+    many_to_many,
+    /// @brief Every value matches the oldest value having the same key
+    ///        in the other source (within the window).
+    ///        Both are discarded (for example, requests and responses).
+    one_to_one
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Join of two sources by key within a window of time
+ *
+ * @note Values of both sources are buffered in a hash index by key.
+ *       When a value arrives, it is matched against the buffered values
+ *       of the other source having the same key, and every matched pair
+ *       is dispatched downstream.
+ * @note Buffered values expire after the window.
+ *       Expired values are evicted in batches, oldest first,
+ *       when a value arrives or advance() is called.
+ *       Memory is bounded by the count of values arriving within the window,
+ *       and optionally by a capacity.
+ * @note The downstream event is dispatched with the lock held,
+ *       so its callbacks must not dispatch the sources
+ *
+ * @tparam Key Key type (hashable)
+ * @tparam L Value type of the left source
+ * @tparam R Value type of the right source
+ * @tparam Clock Clock type
+ * @tparam Lock Lock type (see combine_latest)
+ */
+template <
+    class Key,
+    class L,
+    class R,
+    class Clock = ::std::chrono::steady_clock,
+    class Lock = ::std::mutex>
+class window_join
+{
+public:
+    /// @brief This type
+    using type = window_join<Key, L, R, Clock, Lock>;
+    /// @brief Downstream event type
+    using event_type = event<const L &, const R &>;
+    /// @brief Key extractor of the left source
+    using left_key_type = ::std::function<Key(const L &)>;
+    /// @brief Key extractor of the right source
+    using right_key_type = ::std::function<Key(const R &)>;
+
+    /**
+     * @brief Subscribe to both sources
+     *
+     * @warning All arguments must exceed the lifetime of this instance
+     *
+     * @tparam LeftSource Event or observable
+     * @tparam RightSource Event or observable
+     * @param downstream Downstream event
+     * @param left Left source
+     * @param left_key Key extractor of the left source
+     * @param right Right source
+     * @param right_key Key extractor of the right source
+     * @param window Time a value is buffered
+     * @param mode Join mode
+     * @param capacity Maximum count of buffered values per source.
+     *                 The oldest value is evicted when full.
+     *                 Storage is bounded by twice this count,
+     *                 including matched values not yet removed.
+     */
+    template <class LeftSource, class RightSource>
+    window_join(
+        event_type &downstream,
+        LeftSource &left,
+        left_key_type left_key,
+        RightSource &right,
+        right_key_type right_key,
+        typename Clock::duration window,
+        join_mode mode = join_mode::many_to_many,
+        ::std::size_t capacity = ::std::numeric_limits<::std::size_t>::max())
+        : _downstream{downstream},
+          _left{::std::move(left_key)},
+          _right{::std::move(right_key)},
+          _window{window},
+          _mode{mode},
+          _capacity{(capacity > 0) ? capacity : 1},
+          _left_link{left, [this](const L &value)
+                     { receive_left(value); }},
+          _right_link{right, [this](const R &value)
+                      { receive_right(value); }} {}
+
+    /**
+     * @brief Evict expired values
+     *
+     * @param now Current time
+     */
+    void advance(typename Clock::time_point now = Clock::now())
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        evict(now);
+    }
+
+    /**
+     * @brief Get the count of buffered values
+     *
+     * @return ::std::size_t Count of values of both sources
+     */
+    ::std::size_t size() const
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        return _left.index.size() + _right.index.size();
+    }
+
+    /**
+     * @brief Get the count of evicted values
+     *
+     * @return ::std::size_t Count of values evicted due to expiration
+     *         or capacity since construction
+     */
+    ::std::size_t evicted() const
+    {
+        ::std::lock_guard<Lock> guard(_lock);
+        return _evicted;
+    }
+
+    /// @brief Copy constructor (deleted)
+    window_join(const type &) = delete;
+    /// @brief Copy-assignment (deleted)
+    type &operator=(const type &) = delete;
+
+private:
+    /**
+     * @brief Buffered values of one source
+     *
+     * @tparam T Value type
+     */
+    template <class T>
+    struct side
+    {
+        /// @brief Buffered value
+        struct entry
+        {
+            /// @brief Sequence number (arrival order)
+            ::std::uint64_t sequence;
+            /// @brief Arrival time
+            typename Clock::time_point time;
+            /// @brief Key
+            Key key;
+            /// @brief Value
+            T value;
+            /// @brief False if already removed from the index
+            bool alive;
+        };
+
+        /// @brief Key extractor
+        ::std::function<Key(const T &)> key_of;
+        /// @brief Buffered values in arrival order
+        ::std::deque<entry> fifo{};
+        /// @brief Sequence number of the next value
+        ::std::uint64_t next{0};
+        /// @brief Count of values in fifo removed from the index
+        ::std::size_t dead{0};
+        /// @brief Sequence numbers of alive values by key
+        ::std::unordered_multimap<Key, ::std::uint64_t> index{};
+
+        /**
+         * @brief Create a side
+         *
+         * @param key_of Key extractor
+         */
+        explicit side(::std::function<Key(const T &)> key_of)
+            : key_of{::std::move(key_of)} {}
+
+        /**
+         * @brief Get a buffered value
+         *
+         * @note Logarithmic time
+         *
+         * @param sequence Sequence number
+         * @return entry& Buffered value
+         */
+        entry &at(::std::uint64_t sequence)
+        {
+            return *::std::lower_bound(
+                fifo.begin(),
+                fifo.end(),
+                sequence,
+                [](const entry &item, ::std::uint64_t value)
+                {
+                    return item.sequence < value;
+                });
+        }
+
+        /**
+         * @brief Buffer a value
+         *
+         * @param now Arrival time
+         * @param key Key
+         * @param value Value
+         */
+        void push(typename Clock::time_point now, const Key &key, const T &value)
+        {
+            index.emplace(key, next);
+            fifo.push_back({next++, now, key, value, true});
+        }
+
+        /**
+         * @brief Remove a value from the index
+         *
+         * @note The value is removed from fifo when it gets to the front,
+         *       or when removed values outnumber alive values
+         *       (so fifo is bounded by twice the count of alive values)
+         *
+         * @param it Position in the index
+         */
+        void kill(typename ::std::unordered_multimap<Key, ::std::uint64_t>::iterator it)
+        {
+            at(it->second).alive = false;
+            index.erase(it);
+            if (++dead > index.size())
+            {
+                // Note: linear time, amortized by the removed values
+                fifo.erase(
+                    ::std::remove_if(
+                        fifo.begin(),
+                        fifo.end(),
+                        [](const entry &item)
+                        {
+                            return !item.alive;
+                        }),
+                    fifo.end());
+                dead = 0;
+            }
+        }
+
+        /**
+         * @brief Remove the value at the front of fifo
+         *
+         * @return true if it was alive
+         * @return false otherwise
+         */
+        bool pop()
+        {
+            entry &front = fifo.front();
+            bool alive = front.alive;
+            if (alive)
+            {
+                auto [it, last] = index.equal_range(front.key);
+                while (it->second != front.sequence)
+                    ++it;
+                index.erase(it);
+            }
+            else
+                dead--;
+            fifo.pop_front();
+            return alive;
+        }
+
+        /**
+         * @brief Remove expired values, oldest first
+         *
+         * @param now Current time
+         * @param window Time a value is buffered
+         * @return ::std::size_t Count of alive values removed
+         */
+        ::std::size_t expire(
+            typename Clock::time_point now,
+            typename Clock::duration window)
+        {
+            ::std::size_t count = 0;
+            while (!fifo.empty() &&
+                   (!fifo.front().alive || (now - fifo.front().time >= window)))
+                count += pop();
+            return count;
+        }
+    };
+
+    /**
+     * @brief Match and buffer a value of the left source
+     *
+     * @param value Value
+     */
+    void receive_left(const L &value)
+    {
+        auto now = Clock::now();
+        ::std::lock_guard<Lock> guard(_lock);
+        evict(now);
+        Key key = _left.key_of(value);
+        if (match(_right, key, [this, &value](const R &other)
+                  { _downstream(value, other); }))
+            return;
+        store(_left, now, key, value);
+    }
+
+    /**
+     * @brief Match and buffer a value of the right source
+     *
+     * @param value Value
+     */
+    void receive_right(const R &value)
+    {
+        auto now = Clock::now();
+        ::std::lock_guard<Lock> guard(_lock);
+        evict(now);
+        Key key = _right.key_of(value);
+        if (match(_left, key, [this, &value](const L &other)
+                  { _downstream(other, value); }))
+            return;
+        store(_right, now, key, value);
+    }
+
+    /**
+     * @brief Dispatch matches in the other side
+     *
+     * @note Must be called with the lock held
+     *
+     * @tparam T Value type of the other side
+     * @tparam Emit Dispatcher type
+     * @param other Other side
+     * @param key Key
+     * @param emit Dispatches a match
+     * @return true if the arriving value was consumed (one to one)
+     * @return false if it must be buffered
+     */
+    template <class T, class Emit>
+    bool match(side<T> &other, const Key &key, Emit &&emit)
+    {
+        auto [first, last] = other.index.equal_range(key);
+        if (_mode == join_mode::one_to_one)
+        {
+            if (first == last)
+                return false;
+            // Oldest value having the same key
+            auto oldest = first;
+            for (auto it = first; it != last; ++it)
+                if (it->second < oldest->second)
+                    oldest = it;
+            emit(other.at(oldest->second).value);
+            other.kill(oldest);
+            return true;
+        }
+        for (auto it = first; it != last; ++it)
+            emit(other.at(it->second).value);
+        return false;
+    }
+
+    /**
+     * @brief Buffer a value, evicting the oldest one if full
+     *
+     * @note Must be called with the lock held
+     *
+     * @tparam T Value type
+     * @param target Side
+     * @param now Arrival time
+     * @param key Key
+     * @param value Value
+     */
+    template <class T>
+    void store(side<T> &target, typename Clock::time_point now, const Key &key, const T &value)
+    {
+        while (target.index.size() >= _capacity)
+            _evicted += target.pop();
+        target.push(now, key, value);
+    }
+
+    /**
+     * @brief Evict expired values of both sides
+     *
+     * @note Must be called with the lock held
+     *
+     * @param now Current time
+     */
+    void evict(typename Clock::time_point now)
+    {
+        _evicted += _left.expire(now, _window);
+        _evicted += _right.expire(now, _window);
+    }
+
+    /// @brief Downstream event
+    event_type &_downstream;
+    /// @brief Left source values
+    side<L> _left;
+    /// @brief Right source values
+    side<R> _right;
+    /// @brief Time a value is buffered
+    typename Clock::duration _window;
+    /// @brief Join mode
+    join_mode _mode;
+    /// @brief Maximum count of buffered values per side
+    ::std::size_t _capacity;
+    /// @brief Count of evicted values
+    ::std::size_t _evicted{0};
+    /// @brief Lock
+    mutable Lock _lock{};
+    /// @brief Left subscription (destroyed first)
+    value_subscription<L> _left_link;
+    /// @brief Right subscription (destroyed first)
+    value_subscription<R> _right_link;
+};
+
+//------------------------------------------------------------------------------
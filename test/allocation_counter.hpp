@@ -0,0 +1,133 @@
+/**
+ * @file allocation_counter.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Count of dynamic memory allocations (test units only)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ *
+ */
+
+#pragma once
+
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Count of calls to the global operator new
+ *
+ * @note The global operators new and delete are replaced
+ *       (all of them, so they match each other)
+ * @warning To be included by a single translation unit of each test program
+ */
+inline ::std::atomic<::std::size_t> allocations{0};
+
+namespace allocation_counter
+{
+    /**
+     * @brief Allocate and count
+     *
+     * @param size Size in bytes
+     * @param alignment Alignment in bytes
+     * @return void* Allocated memory
+     */
+    inline void *allocate(::std::size_t size, ::std::size_t alignment)
+    {
+        allocations++;
+        // Note: the address returned by malloc() is stored
+        // right before the aligned block
+        void *raw = ::std::malloc(size + alignment + sizeof(void *));
+        if (!raw)
+            throw ::std::bad_alloc();
+        ::std::uintptr_t address =
+            reinterpret_cast<::std::uintptr_t>(raw) + sizeof(void *);
+        address = (address + alignment - 1) & ~(alignment - 1);
+        reinterpret_cast<void **>(address)[-1] = raw;
+        return reinterpret_cast<void *>(address);
+    }
+
+    /**
+     * @brief Deallocate
+     *
+     * @param p Memory returned by allocate() or null
+     */
+    inline void deallocate(void *p) noexcept
+    {
+        if (p)
+            ::std::free(static_cast<void **>(p)[-1]);
+    }
+} // namespace allocation_counter
+
+//------------------------------------------------------------------------------
+// Replaced operators
+//------------------------------------------------------------------------------
+
+void *operator new(::std::size_t size)
+{
+    return allocation_counter::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](::std::size_t size)
+{
+    return allocation_counter::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(::std::size_t size, ::std::align_val_t alignment)
+{
+    return allocation_counter::allocate(size, static_cast<::std::size_t>(alignment));
+}
+
+void *operator new[](::std::size_t size, ::std::align_val_t alignment)
+{
+    return allocation_counter::allocate(size, static_cast<::std::size_t>(alignment));
+}
+
+void operator delete(void *p) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete(void *p, ::std::size_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete[](void *p, ::std::size_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete(void *p, ::std::align_val_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete[](void *p, ::std::align_val_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete(void *p, ::std::size_t, ::std::align_val_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+void operator delete[](void *p, ::std::size_t, ::std::align_val_t) noexcept
+{
+    allocation_counter::deallocate(p);
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,401 @@
+/**
+ * @file async_event_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (asynchronous dispatch)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "async_event.hpp"
+#include "../allocation_counter.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Mocks
+//------------------------------------------------------------------------------
+
+/// @brief Executor that does not allocate memory once warmed up
+class vector_executor : public executor
+{
+public:
+    vector<task_type> tasks;
+
+    void post(task_type task) override
+    {
+        tasks.push_back(move(task));
+    }
+
+    void run_pending()
+    {
+        for (auto &task : tasks)
+            task();
+        tasks.clear();
+    }
+};
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Single lane delivered in order -" << endl;
+    queue_executor exec;
+    async_event<int, const string &> evt(exec);
+    vector<int> log;
+    auto sh = evt.subscribe([&log](int n, const string &)
+                            { log.push_back(n); });
+    assert(sh.is_subscribed());
+    assert(evt.subscribed() == 1);
+    assert(evt.lanes() == 1);
+
+    evt(1, "one");
+    evt(2, "two");
+    assert(log.empty());
+    // One task per lane, not per dispatch
+    assert(exec.pending() == 1);
+    exec.run_pending();
+    assert((log == vector<int>{1, 2}));
+
+    evt -= sh;
+    evt(3, "three");
+    exec.run_pending();
+    assert(log.size() == 2);
+    evt.wait();
+}
+
+void test2()
+{
+    cout << "- Per-key order across lanes -" << endl;
+    thread_pool pool(4);
+    map<int, vector<int>> received;
+    mutex received_mutex;
+    {
+        async_event<int, int> evt(
+            8,
+            [](int key, int)
+            { return key; },
+            pool);
+        evt += [&](int key, int sequence)
+        {
+            lock_guard<mutex> guard(received_mutex);
+            received[key].push_back(sequence);
+        };
+        for (int sequence = 0; sequence < 1000; sequence++)
+            for (int key = 0; key < 16; key++)
+                evt(key, sequence);
+        evt.wait();
+        assert(received.size() == 16);
+        for (int sequence = 1000; sequence < 1010; sequence++)
+            evt(0, sequence);
+        // destructor waits for delivery
+    }
+    for (auto &[key, sequences] : received)
+    {
+        assert(sequences.size() == ((key == 0) ? 1010u : 1000u));
+        for (size_t i = 0; i < sequences.size(); i++)
+            assert(sequences[i] == static_cast<int>(i));
+    }
+}
+
+void test3()
+{
+    cout << "- Default executor -" << endl;
+    async_event<string> evt;
+    string last;
+    thread::id caller{};
+    evt += [&](const string &text)
+    {
+        last = text;
+        caller = this_thread::get_id();
+    };
+    evt("hello");
+    evt.wait();
+    assert(last == "hello");
+    assert(caller != this_thread::get_id());
+}
+
+void test4()
+{
+    cout << "- Overflow policies -" << endl;
+    queue_executor exec;
+    vector<int> log;
+    auto logger = [&log](int, int value)
+    { log.push_back(value); };
+    {
+        async_event<int, int> evt(exec);
+        evt += logger;
+        evt.set_capacity(2, overflow_policy::drop_newest);
+        evt(0, 1);
+        evt(0, 2);
+        evt(0, 3);
+        exec.run_pending();
+        assert((log == vector<int>{1, 2}));
+        assert(evt.statistics().dropped == 1);
+    }
+    log.clear();
+    {
+        async_event<int, int> evt(exec);
+        evt += logger;
+        evt.set_capacity(2, overflow_policy::drop_oldest);
+        evt(0, 1);
+        evt(0, 2);
+        evt(0, 3);
+        exec.run_pending();
+        assert((log == vector<int>{2, 3}));
+        assert(evt.statistics().dropped == 1);
+    }
+    log.clear();
+    {
+        async_event<int, int> evt(
+            1,
+            [](int key, int)
+            { return key; },
+            exec);
+        evt += logger;
+        evt.set_capacity(2, overflow_policy::conflate);
+        evt(1, 10);
+        evt(2, 20);
+        evt(1, 11);
+        evt(3, 30);
+        exec.run_pending();
+        assert((log == vector<int>{20, 30}));
+        auto stats = evt.statistics();
+        assert(stats.conflated == 1);
+        assert(stats.dropped == 1);
+    }
+    log.clear();
+    {
+        async_event<int, int> evt(exec);
+        evt += logger;
+        evt.set_capacity(1, overflow_policy::block);
+        evt(0, 1);
+        thread consumer([&exec]()
+                        {
+                            this_thread::sleep_for(chrono::milliseconds(20));
+                            exec.run_pending(); });
+        evt(0, 2); // blocks until the consumer takes the first one
+        consumer.join();
+        exec.run_pending();
+        assert((log == vector<int>{1, 2}));
+        auto stats = evt.statistics();
+        assert(stats.dropped == 0);
+        assert(stats.blocked > chrono::nanoseconds::zero());
+    }
+}
+
+void test5()
+{
+    cout << "- Priority levels -" << endl;
+    queue_executor exec;
+    vector<int> log;
+    {
+        async_event<int> evt(exec);
+        evt += [&log](int value)
+        { log.push_back(value); };
+        evt.set_priorities(2);
+        evt(1);
+        evt(2);
+        evt.dispatch(1, 100);
+        evt.dispatch(7, 101); // highest
+        evt(3);
+        exec.run_pending();
+        assert((log == vector<int>{100, 101, 1, 2, 3}));
+    }
+    log.clear();
+    {
+        async_event<int> evt(exec);
+        evt += [&log](int value)
+        { log.push_back(value); };
+        evt.set_priorities({1, 3});
+        for (int i = 1; i <= 4; i++)
+            evt(i);
+        for (int i = 101; i <= 106; i++)
+            evt.dispatch(1, i);
+        exec.run_pending();
+        assert((log == vector<int>{101, 102, 103, 1, 104, 105, 106, 2, 3, 4}));
+    }
+}
+
+void test6()
+{
+    cout << "- Batch callbacks -" << endl;
+    queue_executor exec;
+    async_event<int, const string &> evt(exec);
+    vector<size_t> sizes;
+    vector<int> all;
+    vector<int> items;
+    auto sh1 = evt.subscribe_batch(
+        [&](span<const async_event<int, const string &>::payload_type> batch)
+        {
+            sizes.push_back(batch.size());
+            for (const auto &[n, text] : batch)
+                all.push_back(n);
+        },
+        2);
+    auto sh2 = evt.subscribe_batch(
+        [&](span<const async_event<int, const string &>::payload_type> batch)
+        { assert(batch.size() == 5); });
+    assert(sh1.is_subscribed());
+    assert(sh2.is_subscribed());
+    evt += [&items](int n, const string &)
+    { items.push_back(n); };
+
+    for (int i = 1; i <= 5; i++)
+        evt(i, "x");
+    exec.run_pending();
+    assert((sizes == vector<size_t>{2, 2, 1}));
+    assert((all == vector<int>{1, 2, 3, 4, 5}));
+    assert((items == vector<int>{1, 2, 3, 4, 5}));
+
+    evt.unsubscribe(sh1);
+    evt.unsubscribe(sh2);
+    assert(!sh1.is_subscribed());
+    evt(6, "y");
+    exec.run_pending();
+    assert(all.size() == 5);
+    assert(items.size() == 6);
+
+    // Batches are limited anyway
+    using event_type = async_event<int, const string &>;
+    sizes.clear();
+    auto sh3 = evt.subscribe_batch(
+        [&sizes](span<const event_type::payload_type> batch)
+        { sizes.push_back(batch.size()); },
+        1000);
+    for (size_t i = 0; i < 2 * event_type::batch_limit + 10; i++)
+        evt(0, "z");
+    exec.run_pending();
+    assert((sizes == vector<size_t>{event_type::batch_limit, event_type::batch_limit, 10}));
+    evt.unsubscribe(sh3);
+}
+
+void test7()
+{
+    cout << "- Steady state does not allocate -" << endl;
+    vector_executor exec;
+    exec.tasks.reserve(16);
+    async_event<int, double> evt(
+        2, [](int n, double)
+        { return n % 2; },
+        exec);
+    long long sum = 0;
+    evt += [&sum](int n, double)
+    { sum += n; };
+    auto sh = evt.subscribe_batch(
+        [&sum](span<const async_event<int, double>::payload_type> batch)
+        { sum += batch.size(); });
+
+    auto round = [&]()
+    {
+        for (int i = 0; i < 100; i++)
+            evt(i, 0.5);
+        exec.run_pending();
+    };
+
+    round();
+    size_t before = allocations.load();
+    for (int i = 0; i < 1000; i++)
+        round();
+    assert(allocations.load() == before);
+    assert(sum == 1001LL * (4950 + 100));
+    evt.unsubscribe(sh);
+}
+
+void test8()
+{
+    cout << "- Event data recycled across threads -" << endl;
+    thread_pool pool(2);
+    atomic<long long> sum{0};
+    {
+        async_event<int> evt(
+            4, [](int n)
+            { return n; },
+            pool);
+        evt += [&sum](int n)
+        { sum += n; };
+        vector<thread> producers;
+        for (int t = 0; t < 4; t++)
+            producers.emplace_back(
+                [&evt]()
+                {
+                    for (int i = 1; i <= 10000; i++)
+                        evt(i);
+                });
+        for (auto &producer : producers)
+            producer.join();
+        evt.wait();
+    }
+    assert(sum == 4LL * 10000 * 10001 / 2);
+}
+
+void test9()
+{
+    cout << "- Conflation under a full queue -" << endl;
+    constexpr int keys = 512;
+    vector_executor exec;
+    exec.tasks.reserve(16);
+    vector<pair<int, int>> log;
+    log.reserve(keys + 1);
+    async_event<int, int> evt(
+        1,
+        [](int key, int)
+        { return key; },
+        exec);
+    evt += [&log](int key, int value)
+    { log.push_back({key, value}); };
+    evt.set_capacity(keys, overflow_policy::conflate);
+
+    // Fill the queue, then replace every queued item many times
+    for (int key = 0; key < keys; key++)
+        evt(key, 0);
+    size_t before = allocations.load();
+    for (int round = 1; round <= 20; round++)
+        for (int key = 0; key < keys; key++)
+            evt((key * 7) % keys, round);
+    assert(allocations.load() == before);
+    auto stats = evt.statistics();
+    assert(stats.conflated == 20 * keys);
+    assert(stats.dropped == 0);
+
+    // A new key drops the oldest one
+    evt(keys, 0);
+    assert(evt.statistics().dropped == 1);
+    exec.run_pending();
+    assert(log.size() == keys);
+    for (int key = 1; key < keys; key++)
+        assert(log[key - 1] == make_pair(key, 20));
+    assert(log.back() == make_pair(keys, 0));
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    test6();
+    test7();
+    test8();
+    test9();
+    return 0;
+}
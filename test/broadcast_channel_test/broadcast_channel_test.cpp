@@ -0,0 +1,155 @@
+/**
+ * @file broadcast_channel_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (one producer, many consumer threads)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "broadcast_channel.hpp"
+#include "event.hpp"
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Every consumer receives every message in order -" << endl;
+    vector<int> log1, log2, log3;
+    broadcast_channel<int, const string &> channel(8);
+    assert(channel.capacity() == 8);
+    auto sh1 = channel.subscribe([&log1](int n, const string &)
+                                 { log1.push_back(n); });
+    auto sh2 = channel.subscribe([&log2](int n, const string &)
+                                 { log2.push_back(n); });
+    auto sh3 = channel.subscribe([&log3](int n, const string &text)
+                                 { assert(text == to_string(n));
+                                   log3.push_back(n); });
+    assert(sh1.is_subscribed());
+    assert(sh2.is_subscribed());
+    assert(sh3.is_subscribed());
+    assert(channel.subscribed() == 3);
+    vector<int> expected;
+    for (int i = 0; i < 1000; i++)
+    {
+        channel(i, to_string(i));
+        expected.push_back(i);
+    }
+    channel.wait();
+    assert(log1 == expected);
+    assert(log2 == expected);
+    assert(log3 == expected);
+}
+
+void test2()
+{
+    cout << "- Wait strategies -" << endl;
+    for (auto strategy : {wait_strategy::busy_spin,
+                          wait_strategy::yield,
+                          wait_strategy::block,
+                          wait_strategy::adaptive})
+    {
+        long long sum1 = 0, sum2 = 0;
+        {
+            broadcast_channel<int> channel(256, strategy);
+            channel += [&sum1](int n)
+            { sum1 += n; };
+            channel += [&sum2](int n)
+            { sum2 += n; };
+            for (int i = 1; i <= 10000; i++)
+                channel(i);
+        }
+        assert(sum1 == 10000LL * 10001 / 2);
+        assert(sum2 == 10000LL * 10001 / 2);
+    }
+}
+
+void test3()
+{
+    cout << "- Slow consumer does not lose messages -" << endl;
+    vector<int> fast, slow;
+    broadcast_channel<int> channel(4);
+    channel += [&fast](int n)
+    { fast.push_back(n); };
+    channel += [&slow](int n)
+    {
+        this_thread::sleep_for(chrono::microseconds(200));
+        slow.push_back(n);
+    };
+    for (int i = 0; i < 50; i++)
+        channel(i);
+    channel.wait();
+    assert(fast.size() == 50);
+    assert(slow.size() == 50);
+    assert(fast == slow);
+}
+
+void test4()
+{
+    cout << "- Fed from an event -" << endl;
+    event<int> source;
+    vector<int> log;
+    broadcast_channel<int> channel(2);
+    channel += [&log](int n)
+    { log.push_back(n); };
+    source += ref(channel);
+    for (int i = 0; i < 10; i++)
+        source(i);
+    channel.wait();
+    assert((log == vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+void test5()
+{
+    cout << "- Unsubscribe -" << endl;
+    int count1 = 0, count2 = 0;
+    broadcast_channel<int> channel(4);
+    auto sh1 = channel.subscribe([&count1](int)
+                                 { count1++; });
+    auto sh2 = channel.subscribe([&count2](int)
+                                 { count2++; });
+    for (int i = 0; i < 100; i++)
+        channel(i);
+    channel.wait();
+    channel.unsubscribe(sh2);
+    assert(!sh2.is_subscribed());
+    assert(channel.subscribed() == 1);
+    for (int i = 0; i < 100; i++)
+        channel(i);
+    channel.wait();
+    assert(count1 == 200);
+    assert(count2 == 100);
+    channel.unsubscribe(sh2);
+    channel.unsubscribe(sh1);
+    assert(channel.subscribed() == 0);
+    for (int i = 0; i < 100; i++)
+        channel(i);
+    channel.wait();
+    assert(count1 == 200);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bucket_event_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "bucket_event.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Mocks
+//------------------------------------------------------------------------------
+
+static vector<int> call_log{};
+
+struct Session
+{
+    int id;
+    int *sum;
+
+    void operator()(int value)
+    {
+        *sum += value;
+        call_log.push_back(id);
+    }
+};
+
+void free_callback(int value)
+{
+    call_log.push_back(-value);
+}
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Subscribe/unsubscribe -" << endl;
+    bucket_event<int> evt;
+    int sum = 0;
+    auto sh1 = evt.subscribe(Session{1, &sum});
+    auto sh2 = evt.subscribe(Session{2, &sum});
+    assert(sh1.is_subscribed());
+    assert(sh2.is_subscribed());
+    assert(evt.subscribed() == 2);
+    assert(evt.buckets() == 1);
+
+    evt.unsubscribe(sh1);
+    assert(!sh1.is_subscribed());
+    assert(evt.subscribed() == 1);
+    evt -= sh2;
+    assert(!sh2.is_subscribed());
+    assert(evt.subscribed() == 0);
+    assert(evt.buckets() == 0);
+
+    bucket_event<int>::subscription_handler orphan;
+    evt.unsubscribe(orphan);
+    assert(!orphan.is_subscribed());
+}
+
+void test2()
+{
+    cout << "- Dispatch grouped by callable type -" << endl;
+    bucket_event<int> evt;
+    int sum = 0;
+    int lambda_calls = 0;
+    auto lambda = [&lambda_calls](int)
+    {
+        lambda_calls++;
+    };
+
+    evt += Session{1, &sum};
+    evt += free_callback;
+    evt += Session{2, &sum};
+    auto sh = evt.subscribe(lambda);
+    evt += lambda;
+    evt += Session{3, &sum};
+    assert(evt.subscribed() == 6);
+    assert(evt.buckets() == 3);
+
+    call_log.clear();
+    evt(10);
+    assert(sum == 30);
+    assert(lambda_calls == 2);
+    assert((call_log == vector<int>{1, 2, 3, -10}));
+
+    evt.unsubscribe(sh);
+    evt(1);
+    assert(lambda_calls == 3);
+}
+
+void test3()
+{
+    cout << "- Unsubscribe keeps order -" << endl;
+    bucket_event<int> evt;
+    int sum = 0;
+    evt += Session{1, &sum};
+    auto sh = evt.subscribe(Session{2, &sum});
+    evt += Session{3, &sum};
+
+    evt.unsubscribe(sh);
+    call_log.clear();
+    evt(1);
+    assert((call_log == vector<int>{1, 3}));
+}
+
+void test4()
+{
+    cout << "- Move -" << endl;
+    bucket_event<int> source;
+    int sum = 0;
+    source.subscribe(Session{1, &sum});
+    bucket_event<int> dest{::std::move(source)};
+    assert(source.subscribed() == 0);
+    assert(dest.subscribed() == 1);
+
+    bucket_event<int> other;
+    other = ::std::move(dest);
+    assert(dest.subscribed() == 0);
+    assert(other.subscribed() == 1);
+    other(5);
+    assert(sum == 5);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
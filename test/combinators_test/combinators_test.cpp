@@ -0,0 +1,161 @@
+/**
+ * @file combinators_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Combine latest, zip and merge of events and observables
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "combinators.hpp"
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Combine latest -" << endl;
+    event<int> numbers;
+    event<const string &> names;
+    observable<double> ratio{0.5};
+    combine_latest<no_lock, int, string, double>::event_type downstream;
+    vector<tuple<int, string, double>> log;
+    downstream += [&log](const int &n, const string &name, const double &r)
+    { log.push_back({n, name, r}); };
+    {
+        combine_latest<no_lock, int, string, double> combined(
+            downstream, numbers, names, ratio);
+        assert(numbers.subscribed() == 1);
+        assert(ratio.on_change.subscribed() == 1);
+
+        numbers(1);
+        names("a");
+        numbers(2);
+        assert(log.empty());
+        assert(!combined.ready());
+        ratio = 1.5;
+        assert(combined.ready());
+        assert((log == vector<tuple<int, string, double>>{{2, "a", 1.5}}));
+        names("b");
+        assert(log.size() == 2);
+        assert(log.back() == make_tuple(2, string("b"), 1.5));
+    }
+    // Unsubscribed on destruction
+    assert(numbers.subscribed() == 0);
+    assert(names.subscribed() == 0);
+    assert(ratio.on_change.subscribed() == 0);
+    numbers(3);
+    assert(log.size() == 2);
+}
+
+void test2()
+{
+    cout << "- Zip -" << endl;
+    event<int> left;
+    event<string> right;
+    zip<no_lock, int, string>::event_type downstream;
+    vector<pair<int, string>> log;
+    downstream += [&log](const int &n, const string &text)
+    { log.push_back({n, text}); };
+    zip<no_lock, int, string> zipped(downstream, 2, left, right);
+
+    left(1);
+    left(2);
+    assert(log.empty());
+    right("a");
+    assert((log == vector<pair<int, string>>{{1, "a"}}));
+    right("b");
+    right("c");
+    assert((log == vector<pair<int, string>>{{1, "a"}, {2, "b"}}));
+    left(3);
+    assert(log.back() == make_pair(3, string("c")));
+
+    // Bounded: the oldest value is dropped
+    left(4);
+    left(5);
+    left(6);
+    assert(zipped.dropped() == 1);
+    right("d");
+    assert(log.back() == make_pair(5, string("d")));
+    assert(log.size() == 4);
+}
+
+void test3()
+{
+    cout << "- Merge -" << endl;
+    event<int> a;
+    event<const int &> b;
+    observable<int> c{0};
+    merger<no_lock, int>::event_type downstream;
+    vector<int> log;
+    downstream += [&log](const int &n)
+    { log.push_back(n); };
+    merger<no_lock, int> merged(downstream, a, b, c);
+    a(1);
+    b(2);
+    c = 3;
+    a(4);
+    assert((log == vector<int>{1, 2, 3, 4}));
+}
+
+void test4()
+{
+    cout << "- Sources in several threads -" << endl;
+    event<int> a, b;
+    combine_latest<mutex, int, int>::event_type combined_out;
+    merger<mutex, int>::event_type merged_out;
+    zip<mutex, int, int>::event_type zipped_out;
+    // Callbacks are serialized by the lock: no need to synchronize
+    int combined_count = 0;
+    int merged_count = 0;
+    int zipped_count = 0;
+    combined_out += [&combined_count](const int &, const int &)
+    { combined_count++; };
+    merged_out += [&merged_count](const int &)
+    { merged_count++; };
+    zipped_out += [&zipped_count](const int &x, const int &y)
+    {
+        assert(x == y);
+        zipped_count++;
+    };
+    combine_latest<mutex, int, int> combined(combined_out, a, b);
+    merger<mutex, int> merged(merged_out, a, b);
+    zip<mutex, int, int> zipped(zipped_out, 1000, a, b);
+
+    constexpr int count = 1000;
+    thread t1([&a]()
+              { for (int i = 0; i < count; i++) a(i); });
+    thread t2([&b]()
+              { for (int i = 0; i < count; i++) b(i); });
+    t1.join();
+    t2.join();
+    assert(merged_count == 2 * count);
+    assert(zipped_count == count);
+    assert(zipped.dropped() == 0);
+    assert(combined_count >= count);
+    assert(combined_count < 2 * count);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
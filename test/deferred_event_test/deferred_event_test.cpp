@@ -0,0 +1,148 @@
+/**
+ * @file deferred_event_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (deferred dispatch)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "deferred_event.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Delivered on flush -" << endl;
+    deferred_event<int, const string &> evt;
+    vector<pair<int, string>> log;
+    auto sh = evt.subscribe([&log](int n, const string &text)
+                            { log.push_back({n, text}); });
+    assert(sh.is_subscribed());
+    assert(evt.subscribed() == 1);
+
+    string text = "one";
+    evt(1, text);
+    text = "changed";
+    evt(2, "two");
+    evt(1, "one");
+    assert(log.empty());
+    assert(evt.pending() == 3);
+    assert(evt.flush() == 3);
+    assert((log == vector<pair<int, string>>{{1, "one"}, {2, "two"}, {1, "one"}}));
+    assert(evt.pending() == 0);
+    assert(evt.flush() == 0);
+    assert(evt.coalesced() == 0);
+
+    evt(3, "three");
+    evt.discard();
+    assert(evt.flush() == 0);
+    assert(log.size() == 3);
+
+    evt -= sh;
+    evt(4, "four");
+    assert(evt.flush() == 1);
+    assert(log.size() == 3);
+}
+
+void test2()
+{
+    cout << "- Coalescing identical event data -" << endl;
+    deferred_event<> layout_dirty(coalescing::identical);
+    int layouts = 0;
+    layout_dirty += [&layouts]()
+    { layouts++; };
+    for (int i = 0; i < 100; i++)
+        layout_dirty();
+    assert(layout_dirty.pending() == 1);
+    assert(layout_dirty.coalesced() == 99);
+    layout_dirty.flush();
+    assert(layouts == 1);
+
+    deferred_event<int, string> evt(coalescing::identical);
+    vector<int> log;
+    evt += [&log](int n, string)
+    { log.push_back(n); };
+    evt(1, "a");
+    evt(2, "a");
+    evt(1, "a");
+    evt(1, "b");
+    evt.flush();
+    assert((log == vector<int>{1, 2, 1}));
+    assert(evt.coalesced() == 1);
+
+    deferred_event<int> plain(coalescing::none);
+    plain(1);
+    plain(1);
+    assert(plain.pending() == 2);
+}
+
+void test3()
+{
+    cout << "- Coalescing by key -" << endl;
+    deferred_event<int, const string &> evt(
+        [](int id, const string &)
+        { return id; });
+    vector<pair<int, string>> log;
+    evt += [&log](int id, const string &text)
+    { log.push_back({id, text}); };
+    evt(1, "a");
+    evt(2, "b");
+    evt(1, "c");
+    evt(3, "d");
+    evt(2, "e");
+    assert(evt.pending() == 3);
+    assert(evt.coalesced() == 2);
+    evt.flush();
+    assert((log == vector<pair<int, string>>{{1, "c"}, {2, "e"}, {3, "d"}}));
+
+    // Index is cleared on flush
+    log.clear();
+    evt(1, "f");
+    evt.flush();
+    assert((log == vector<pair<int, string>>{{1, "f"}}));
+}
+
+void test4()
+{
+    cout << "- Dispatch from callbacks -" << endl;
+    deferred_event<int> evt;
+    vector<int> log;
+    evt += [&log, &evt](int n)
+    {
+        log.push_back(n);
+        if (n < 3)
+            evt(n + 1);
+        assert(evt.flush() == 0);
+    };
+    evt(1);
+    assert(evt.flush() == 1);
+    assert((log == vector<int>{1}));
+    assert(evt.flush() == 1);
+    assert(evt.flush() == 1);
+    assert(evt.flush() == 0);
+    assert((log == vector<int>{1, 2, 3}));
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
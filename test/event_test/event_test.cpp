@@ -9,8 +9,17 @@
  */
 
 #include "event.hpp"
+#include "thread_pool.hpp"
+#include "../allocation_counter.hpp"
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -58,6 +67,47 @@ struct IntDoubleMock
     }
 };
 
+struct ArenaCallback
+{
+    inline static int alive = 0;
+    int *witness;
+    int payload[16]{};
+
+    ArenaCallback(int *witness) : witness{witness} { alive++; }
+    ArenaCallback(const ArenaCallback &other) : witness{other.witness} { alive++; }
+    ~ArenaCallback() { alive--; }
+
+    void operator()(int value)
+    {
+        payload[0] += value;
+        *witness = payload[0];
+    }
+};
+
+struct CountingResource : ::std::pmr::memory_resource
+{
+    int allocations = 0;
+    int outstanding = 0;
+
+    void *do_allocate(::std::size_t bytes, ::std::size_t alignment) override
+    {
+        allocations++;
+        outstanding++;
+        return ::std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, ::std::size_t bytes, ::std::size_t alignment) override
+    {
+        outstanding--;
+        ::std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const ::std::pmr::memory_resource &other) const noexcept override
+    {
+        return (this == &other);
+    }
+};
+
 //------------------------------------------------------------------------------
 // Tests
 //------------------------------------------------------------------------------
@@ -341,6 +391,545 @@ void test11()
     assert(!sh1.is_subscribed());
 }
 
+void test12()
+{
+    cout << "- Reserve, shrink and memory resources -" << endl;
+    {
+        event evt;
+        assert(evt.get_memory_resource() == ::std::pmr::get_default_resource());
+        evt.reserve(8);
+        assert(evt.capacity() >= 8);
+        evt.subscribe(Mock::class_callback);
+        evt.shrink_to_fit();
+        assert(evt.subscribed() == 1);
+    }
+    {
+        // Subscriber storage must not use anything else than the arena
+        ::std::byte buffer[1024];
+        ::std::pmr::monotonic_buffer_resource arena(
+            buffer,
+            sizeof(buffer),
+            ::std::pmr::null_memory_resource());
+        event evt(&arena);
+        assert(evt.get_memory_resource() == &arena);
+        evt.reserve(4);
+        for (int i = 0; i < 4; i++)
+            evt.subscribe(Mock::class_callback);
+        Mock::class_clear();
+        evt();
+        assert(Mock::class_executed_counter == 4);
+
+        event copy{evt};
+        assert(copy.get_memory_resource() == &arena);
+        assert(copy.subscribed() == 4);
+
+        // Move-assignment across memory resources
+        event other;
+        other.subscribe(Mock::class_callback);
+        other = ::std::move(copy);
+        assert(other.subscribed() == 4);
+        assert(copy.subscribed() == 1);
+        // Subscriptions are copied to the resource of their new owner
+        assert(other.get_memory_resource() == ::std::pmr::get_default_resource());
+        assert(copy.get_memory_resource() == &arena);
+        Mock::class_clear();
+        other();
+        assert(Mock::class_executed_counter == 4);
+    }
+}
+
+void test13()
+{
+    cout << "- Callable objects stored in the memory resource -" << endl;
+    alignas(::std::max_align_t) ::std::byte buffer[4096];
+    ::std::pmr::monotonic_buffer_resource arena(
+        buffer,
+        sizeof(buffer),
+        ::std::pmr::null_memory_resource());
+    int witness1 = 0;
+    int witness2 = 0;
+    {
+        event<int> evt(&arena);
+        auto sh1 = evt.emplace(ArenaCallback(&witness1));
+        auto sh2 = evt.emplace(ArenaCallback(&witness2));
+        assert(sh1.is_subscribed());
+        assert(sh2.is_subscribed());
+        assert(evt.subscribed() == 2);
+        assert(ArenaCallback::alive == 2);
+
+        evt(3);
+        evt(4);
+        assert(witness1 == 7);
+        assert(witness2 == 7);
+
+        evt.unsubscribe(sh1);
+        assert(ArenaCallback::alive == 1);
+        evt(1);
+        assert(witness1 == 7);
+        assert(witness2 == 8);
+    }
+    assert(ArenaCallback::alive == 0);
+    arena.release();
+}
+
+void test14()
+{
+    cout << "- Copy-on-write -" << endl;
+    CountingResource resource;
+    event evt(&resource);
+    auto sh1 = evt.subscribe(Mock::class_callback);
+    auto sh2 = evt.subscribe(Mock::class_callback);
+    int allocations = resource.allocations;
+
+    // Copies share the list of subscribers
+    event copy1{evt};
+    event copy2;
+    copy2 = evt;
+    assert(resource.allocations == allocations);
+    assert(copy1.subscribed() == 2);
+    assert(copy2.subscribed() == 2);
+
+    // The list is copied on the first change
+    evt.unsubscribe(sh1);
+    assert(resource.allocations > allocations);
+    assert(evt.subscribed() == 1);
+    assert(copy1.subscribed() == 2);
+    assert(copy2.subscribed() == 2);
+
+    Mock::class_clear();
+    copy1();
+    assert(Mock::class_executed_counter == 2);
+
+    // Handlers do not match subscriptions in copies
+    copy1.unsubscribe(sh2);
+    assert(sh2.is_subscribed());
+    assert(copy1.subscribed() == 2);
+    auto sh3 = copy1.subscribe(Mock::class_callback);
+    assert(copy1.subscribed() == 3);
+    copy1.unsubscribe(sh3);
+    assert(copy1.subscribed() == 2);
+    assert(copy2.subscribed() == 2);
+}
+
+void test15()
+{
+    cout << "- Callbacks subscribed to executors -" << endl;
+    queue_executor executor1;
+    queue_executor executor2;
+    string text1, text2, text3, inline_text;
+    {
+        event<int, const string &> evt;
+        evt.subscribe(
+            [&text1](int, const string &text)
+            { text1 = text; },
+            executor1);
+        evt.subscribe(
+            [&inline_text](int, const string &text)
+            { inline_text = text; });
+        auto sh = evt.subscribe(
+            [&text2](int, const string &text)
+            { text2 = text; },
+            executor1);
+        evt.subscribe(
+            [&text3](int, const string &text)
+            { text3 = text; },
+            executor2);
+        assert(evt.subscribed() == 4);
+
+        // Executors are woken once per dispatch
+        evt(1, "first");
+        assert(inline_text == "first");
+        assert(text1.empty() && text2.empty() && text3.empty());
+        assert(executor1.pending() == 1);
+        assert(executor2.pending() == 1);
+        assert(executor1.run_pending() == 1);
+        assert(text1 == "first");
+        assert(text2 == "first");
+        assert(text3.empty());
+        assert(executor2.run_pending() == 1);
+        assert(text3 == "first");
+
+        // No calls after unsubscription
+        evt(2, "second");
+        evt.unsubscribe(sh);
+        executor1.run_pending();
+        assert(text1 == "second");
+        assert(text2 == "first");
+
+        // The remaining subscription still receives the payload
+        evt.unsubscribe(sh);
+        evt(3, "third");
+        executor1.run_pending();
+        assert(text1 == "third");
+        executor2.run_pending();
+        assert(text3 == "third");
+
+        evt(4, "fourth");
+    }
+    // No calls after destruction
+    executor1.run_pending();
+    executor2.run_pending();
+    assert(text1 == "third");
+    assert(text3 == "third");
+}
+
+void test16()
+{
+    cout << "- Callbacks executed in another thread -" << endl;
+    queue_executor executor;
+    event<int> evt;
+    thread::id caller_id{};
+    int sum = 0;
+    evt.subscribe(
+        [&](int value)
+        {
+            caller_id = this_thread::get_id();
+            sum += value;
+        },
+        executor);
+
+    thread consumer([&]()
+                    {
+                        int count = 0;
+                        while (count < 100)
+                            count += executor.wait_and_run_pending(); });
+    for (int i = 0; i < 100; i++)
+        evt(i);
+    consumer.join();
+    assert(sum == 4950);
+    assert(caller_id != this_thread::get_id());
+    assert(caller_id != thread::id{});
+}
+
+void test17()
+{
+    cout << "- Event data shared among executors -" << endl;
+    queue_executor executor1;
+    queue_executor executor2;
+    const string *address1 = nullptr;
+    const string *address2 = nullptr;
+    const string *address3 = nullptr;
+    event<const string &> evt;
+    evt.subscribe(
+        [&address1](const string &text)
+        { address1 = &text; },
+        executor1);
+    evt.subscribe(
+        [&address2](const string &text)
+        { address2 = &text; },
+        executor2);
+    evt.subscribe(
+        [&address3](const string &text)
+        { address3 = &text; },
+        executor2);
+
+    string text{"a string long enough to be allocated in the heap"};
+    evt(text);
+    executor1.run_pending();
+    executor2.run_pending();
+    assert(address1 != nullptr);
+    assert(address1 != &text);
+    assert(address1 == address2);
+    assert(address2 == address3);
+}
+
+void test18()
+{
+    cout << "- Slow callbacks are demoted -" << endl;
+    queue_executor fallback;
+    event<int> evt;
+    bool slow = true;
+    vector<int> fast_log, slow_log;
+    evt.set_latency_budget(chrono::milliseconds(2), fallback);
+    auto sh1 = evt.subscribe([&fast_log](int n)
+                             { fast_log.push_back(n); });
+    auto sh2 = evt.subscribe(
+        [&slow, &slow_log](int n)
+        {
+            if (slow)
+                this_thread::sleep_for(chrono::milliseconds(20));
+            slow_log.push_back(n);
+        });
+    assert(!evt.is_demoted(sh1));
+    assert(!evt.is_demoted(sh2));
+    assert(evt.demoted() == 0);
+
+    // First call is synchronous, then demoted
+    evt(1);
+    assert((slow_log == vector<int>{1}));
+    assert(!evt.is_demoted(sh1));
+    assert(evt.is_demoted(sh2));
+    assert(evt.demoted() == 1);
+
+    // Demoted: posted to the executor
+    evt(2);
+    assert((fast_log == vector<int>{1, 2}));
+    assert((slow_log == vector<int>{1}));
+    assert(fallback.pending() == 1);
+    fallback.run_pending();
+    assert((slow_log == vector<int>{1, 2}));
+
+    // Recovered: promoted back
+    slow = false;
+    int n = 3;
+    for (; evt.is_demoted(sh2) && (n < 100); n++)
+    {
+        evt(n);
+        fallback.run_pending();
+    }
+    assert(!evt.is_demoted(sh2));
+    assert(evt.demoted() == 0);
+    evt(n);
+    assert(fallback.pending() == 0);
+    assert(slow_log.size() == static_cast<size_t>(n));
+    for (int i = 0; i < n; i++)
+        assert(slow_log[i] == i + 1);
+
+    // No calls after unsubscription
+    slow = true;
+    evt(n + 1);
+    evt(n + 2);
+    assert(evt.is_demoted(sh2));
+    evt.unsubscribe(sh2);
+    fallback.run_pending();
+    assert(slow_log.size() == static_cast<size_t>(n + 1));
+    assert(evt.demoted() == 0);
+
+    // Disabled
+    evt.set_latency_budget(chrono::nanoseconds::zero(), fallback);
+    evt += [](int)
+    { this_thread::sleep_for(chrono::milliseconds(5)); };
+    evt(0);
+    assert(evt.demoted() == 0);
+}
+
+void test19()
+{
+    cout << "- Resumable dispatch -" << endl;
+    event<int, const string &> evt;
+    vector<int> log;
+    auto make = [&log](int id)
+    {
+        return [&log, id](int n, const string &text)
+        {
+            assert(text == "frame");
+            this_thread::sleep_for(chrono::microseconds(500));
+            log.push_back(id * 100 + n);
+        };
+    };
+    auto sh1 = evt.subscribe(make(1));
+    auto sh2 = evt.subscribe(make(2));
+    auto sh3 = evt.subscribe(make(3));
+    auto sh4 = evt.subscribe(make(4));
+    assert(sh1.is_subscribed() && sh2.is_subscribed() && sh4.is_subscribed());
+
+    string text = "frame";
+    auto cursor = evt.begin_dispatch(7, text);
+    text = "changed";
+    assert(!cursor.done());
+    assert(cursor.pending() == 4);
+    assert(log.empty());
+
+    // At least one callback per call
+    assert(!cursor.resume(chrono::nanoseconds::zero()));
+    assert((log == vector<int>{107}));
+    assert(cursor.pending() == 3);
+
+    // Unsubscribed and subscribed meanwhile
+    evt.unsubscribe(sh3);
+    auto sh5 = evt.subscribe(make(5));
+    assert(sh5.is_subscribed());
+    while (!cursor.resume(chrono::nanoseconds::zero()))
+        ;
+    assert(cursor.done());
+    assert(cursor.pending() == 0);
+    assert((log == vector<int>{107, 207, 407}));
+    assert(cursor.resume(chrono::seconds(1)));
+    assert(log.size() == 3);
+
+    // Enough budget for all
+    log.clear();
+    auto cursor2 = evt.begin_dispatch(8, "frame");
+    assert(cursor2.resume(chrono::seconds(10)));
+    assert((log == vector<int>{108, 208, 408, 508}));
+
+    // Nothing to dispatch
+    event<int, const string &> empty;
+    auto cursor3 = empty.begin_dispatch(0, "frame");
+    assert(cursor3.done());
+    assert(cursor3.resume(chrono::nanoseconds::zero()));
+}
+
+void test20()
+{
+    cout << "- Move-assignment across memory resources -" << endl;
+    queue_executor executor;
+    int witness = 0;
+    vector<int> log;
+    event<int> other;
+    CountingResource resource;
+    {
+        event<int> evt(&resource);
+        evt.set_latency_budget(chrono::seconds(10), executor);
+        evt.subscribe([&log](int n)
+                      { log.push_back(n); });
+        evt.subscribe([&log](int n)
+                      { log.push_back(-n); },
+                      executor);
+        evt.emplace([&witness, sum = 0](int n) mutable
+                    { witness = (sum += n); });
+        evt(1);
+        other = ::std::move(evt);
+        assert(other.subscribed() == 3);
+        assert(evt.subscribed() == 0);
+    }
+    // Pending calls are cancelled
+    executor.run_pending();
+    assert((log == vector<int>{1}));
+    // No memory of the source resource is kept
+    assert(resource.outstanding == 0);
+    other(2);
+    executor.run_pending();
+    assert((log == vector<int>{1, 2, -2}));
+    assert(witness == 3);
+
+    // Arena released after move-assignment
+    auto arena = ::std::make_unique<::std::pmr::monotonic_buffer_resource>();
+    auto source = ::std::make_unique<event<int>>(arena.get());
+    source->subscribe([&log](int n)
+                      { log.push_back(n); });
+    other = ::std::move(*source);
+    source.reset();
+    arena.reset();
+    log.clear();
+    other(3);
+    assert((log == vector<int>{3}));
+}
+
+void test21()
+{
+    cout << "- Many executors -" << endl;
+    constexpr int count = 64;
+    vector<queue_executor> executors(count);
+    vector<string> log(count);
+    vector<event<int>::subscription_handler> handlers;
+    event<int> evt;
+    // Interleaved subscriptions
+    for (int round = 0; round < 3; round++)
+        for (int i = 0; i < count; i++)
+        {
+            handlers.push_back(evt.subscribe(
+                [&log, i, round](int n)
+                { log[i] += to_string(round * 10 + n); },
+                executors[i]));
+            handlers.push_back(evt.subscribe([](int) {}));
+        }
+    // Following entries are shifted
+    evt.unsubscribe(handlers[1]);
+    evt.unsubscribe(handlers[2 * count + 4]);
+    evt(1);
+    for (int i = 0; i < count; i++)
+    {
+        assert(executors[i].pending() == 1);
+        executors[i].run_pending();
+        assert(log[i] == ((i == 2) ? "121" : "11121"));
+    }
+}
+
+void test22()
+{
+    cout << "- Demoted callbacks in a pool of threads -" << endl;
+    constexpr int count = 40;
+    thread_pool pool(4);
+    event<int> evt;
+    evt.set_latency_budget(chrono::microseconds(100), pool);
+    atomic<int> running{0};
+    atomic<bool> overlapped{false};
+    atomic<int> calls{0};
+    vector<int> log;
+    auto sh = evt.subscribe(
+        [&](int n)
+        {
+            if (running.fetch_add(1) != 0)
+                overlapped = true;
+            this_thread::sleep_for(chrono::milliseconds(1));
+            log.push_back(n);
+            running--;
+            calls++;
+        });
+    for (int i = 0; i < count; i++)
+        evt(i);
+    assert(evt.is_demoted(sh));
+    while (calls.load() < count)
+        this_thread::yield();
+    assert(!overlapped);
+    for (int i = 0; i < count; i++)
+        assert(log[i] == i);
+}
+
+void test23()
+{
+    cout << "- Latency budget changed while calls are pending -" << endl;
+    queue_executor first;
+    queue_executor second;
+    event<int> evt;
+    evt.set_latency_budget(chrono::microseconds(100), first);
+    vector<int> log;
+    auto sh = evt.subscribe(
+        [&log](int n)
+        {
+            if (n == 0)
+                this_thread::sleep_for(chrono::milliseconds(1));
+            log.push_back(n);
+        });
+    evt(0);
+    assert(evt.is_demoted(sh));
+    evt(1);
+    evt(2);
+    // Pending calls are kept in order, whatever the budget
+    evt.set_latency_budget(chrono::nanoseconds::zero(), second);
+    evt(3);
+    evt.set_latency_budget(chrono::seconds(1), second);
+    evt(4);
+    assert((log == vector<int>{0}));
+    assert(second.run_pending() == 0);
+    first.run_pending();
+    assert((log == vector<int>{0, 1, 2, 3, 4}));
+    // Promoted
+    assert(!evt.is_demoted(sh));
+    evt(5);
+    assert(log.back() == 5);
+    assert(first.run_pending() == 0);
+    assert(second.run_pending() == 0);
+}
+
+void test24()
+{
+    cout << "- Subscriptions to executors use the memory resource -" << endl;
+    constexpr int count = 64;
+    vector<queue_executor> executors(count);
+    vector<event<int>::subscription_handler> handlers;
+    handlers.reserve(2 * count);
+    alignas(max_align_t) static byte buffer[128 * 1024];
+    ::std::pmr::monotonic_buffer_resource arena(
+        buffer, sizeof(buffer), ::std::pmr::null_memory_resource());
+    event<int> evt(&arena);
+    size_t before = allocations.load();
+    // Few executors, then many
+    for (int i = 0; i < 2 * count; i++)
+        handlers.push_back(evt.subscribe(
+            [](int) {},
+            executors[(i < count) ? (i % 2) : (i % count)]));
+    evt.unsubscribe(handlers[0]);
+    assert(allocations.load() == before);
+    evt(1);
+    for (auto &executor : executors)
+    {
+        assert(executor.pending() == 1);
+        executor.run_pending();
+    }
+}
+
 //------------------------------------------------------------------------------
 // Main
 //------------------------------------------------------------------------------
@@ -358,5 +947,18 @@ int main()
     test9();
     test10();
     test11();
+    test12();
+    test13();
+    test14();
+    test15();
+    test16();
+    test17();
+    test18();
+    test19();
+    test20();
+    test21();
+    test22();
+    test23();
+    test24();
     return 0;
 }
\ No newline at end of file
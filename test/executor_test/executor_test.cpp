@@ -0,0 +1,83 @@
+/**
+ * @file executor_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Execution of callbacks in a thread of choice
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "executor.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Run pending tasks in order -" << endl;
+    queue_executor exec;
+    vector<int> log;
+    assert(exec.run_pending() == 0);
+    exec.post([&log]()
+              { log.push_back(1); });
+    exec.post([&log]()
+              { log.push_back(2); });
+    assert(exec.pending() == 2);
+    assert(log.empty());
+    assert(exec.run_pending() == 2);
+    assert(exec.pending() == 0);
+    assert((log == vector<int>{1, 2}));
+}
+
+void test2()
+{
+    cout << "- Tasks posted by a task are not run in the same call -" << endl;
+    queue_executor exec;
+    int count = 0;
+    exec.post([&]()
+              {
+                  count++;
+                  exec.post([&count]()
+                            { count++; }); });
+    assert(exec.run_pending() == 1);
+    assert(count == 1);
+    assert(exec.run_pending() == 1);
+    assert(count == 2);
+}
+
+void test3()
+{
+    cout << "- Wait for tasks posted by another thread -" << endl;
+    queue_executor exec;
+    int sum = 0;
+    thread producer([&]()
+                    {
+                        for (int i = 1; i <= 10; i++)
+                            exec.post([&sum, i]()
+                                      { sum += i; }); });
+    int count = 0;
+    while (count < 10)
+        count += exec.wait_and_run_pending();
+    producer.join();
+    assert(sum == 55);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    return 0;
+}
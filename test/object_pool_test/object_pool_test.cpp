@@ -0,0 +1,142 @@
+/**
+ * @file object_pool_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Recycling of objects
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "object_pool.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Fixtures
+//------------------------------------------------------------------------------
+
+atomic<int> alive{0};
+
+struct Tracked
+{
+    string text;
+
+    Tracked(const string &text) : text{text} { alive++; }
+    ~Tracked() { alive--; }
+};
+
+using pool = object_pool<Tracked>;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Same thread recycling -" << endl;
+    auto *a = pool::acquire("a");
+    assert(a->value().text == "a");
+    assert(alive == 1);
+    pool::release(a);
+    assert(alive == 0);
+    auto *b = pool::acquire("b");
+    assert(b == a);
+    assert(b->value().text == "b");
+    auto *c = pool::acquire("c");
+    assert(c != b);
+    pool::release(b);
+    pool::release(c);
+    assert(alive == 0);
+}
+
+void test2()
+{
+    cout << "- Return to the owning thread -" << endl;
+    vector<pool::node *> nodes;
+    for (int i = 0; i < 10; i++)
+        nodes.push_back(pool::acquire(to_string(i)));
+    thread other([&nodes]()
+                 {
+                     for (auto *node : nodes)
+                         pool::release(node);
+                 });
+    other.join();
+    assert(alive == 0);
+
+    // Recycled by this thread, not by the other one
+    vector<pool::node *> recycled;
+    for (int i = 0; i < 10; i++)
+        recycled.push_back(pool::acquire("x"));
+    for (auto *node : nodes)
+    {
+        bool found = false;
+        for (auto *r : recycled)
+            found = found || (r == node);
+        assert(found);
+    }
+    for (auto *node : recycled)
+        pool::release(node);
+}
+
+void test3()
+{
+    cout << "- Owning thread exits first -" << endl;
+    vector<pool::node *> nodes;
+    thread owner([&nodes]()
+                 {
+                     for (int i = 0; i < 10; i++)
+                         nodes.push_back(pool::acquire(to_string(i)));
+                     pool::release(pool::acquire("y"));
+                 });
+    owner.join();
+    assert(alive == 10);
+    for (auto *node : nodes)
+        pool::release(node);
+    assert(alive == 0);
+}
+
+void test4()
+{
+    cout << "- Concurrent returns -" << endl;
+    constexpr int count = 20000;
+    atomic<pool::node *> slot{nullptr};
+    atomic<bool> done{false};
+    thread consumer([&]()
+                    {
+                        while (!done || slot.load())
+                            if (auto *node = slot.exchange(nullptr))
+                                pool::release(node);
+                            else
+                                this_thread::yield();
+                    });
+    for (int i = 0; i < count; i++)
+    {
+        auto *node = pool::acquire("z");
+        while (slot.load())
+            this_thread::yield();
+        slot.store(node);
+    }
+    done = true;
+    consumer.join();
+    assert(alive == 0);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include "observable.hpp"
 #include <cassert>
 #include <iostream>
+#include <type_traits>
 
 using namespace std;
 
@@ -224,6 +225,55 @@ void test7()
     assert(var_ro == 20);
 }
 
+void test8()
+{
+    cout << "- Copies do not share subscriptions after changes -" << endl;
+    observable<int> var{1};
+    var.on_change.subscribe(&Mock::member_callback, &mock1);
+    observable<int> copy{0};
+    copy = var;
+    assert(copy == 1);
+
+    var.on_change.subscribe(&Mock::member_callback, &mock2);
+    assert(var.on_change.subscribed() == 2);
+    assert(copy.on_change.subscribed() == 1);
+
+    mock1.actual = 0;
+    mock2.actual = 0;
+    copy = 5;
+    mock1.expected = 5;
+    mock2.expected = 0;
+    assert(mock1.check());
+    assert(mock2.check());
+}
+
+void test9()
+{
+    cout << "- Postfix operators and previous values -" << endl;
+    observable<int> var{0};
+    var.on_change.subscribe(&Mock::member_callback, &mock1);
+
+    int old_value = var++;
+    static_assert(::std::is_same_v<decltype(var++), int>);
+    assert(old_value == 0);
+    assert(var == 1);
+    mock1.expected = 1;
+    assert(mock1.check());
+
+    old_value = var--;
+    assert(old_value == 1);
+    assert(var == 0);
+
+    assert(var.fetch_add(5) == 0);
+    assert(var == 5);
+    assert(var.fetch_sub(2) == 5);
+    assert(var == 3);
+    assert(var.exchange(7) == 3);
+    assert(var == 7);
+    mock1.expected = 7;
+    assert(mock1.check());
+}
+
 //------------------------------------------------------------------------------
 // Main
 //------------------------------------------------------------------------------
@@ -237,5 +287,7 @@ int main()
     test5();
     test6();
     test7();
+    test8();
+    test9();
     return 0;
 }
\ No newline at end of file
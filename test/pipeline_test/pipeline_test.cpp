@@ -0,0 +1,161 @@
+/**
+ * @file pipeline_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Operator pipelines over events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "pipeline.hpp"
+#include "event.hpp"
+#include "observable.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Filter and map -" << endl;
+    event<int> evt;
+    vector<string> log;
+    auto h = evt |
+             ops::filter([](int n)
+                          { return n % 2 == 0; }) |
+             ops::map([](int n)
+                       { return to_string(n * 10); }) |
+             ops::sink([&log](const string &text)
+                        { log.push_back(text); });
+    assert(h.is_subscribed());
+    assert(evt.subscribed() == 1);
+    for (int i = 1; i <= 5; i++)
+        evt(i);
+    assert((log == vector<string>{"20", "40"}));
+
+    evt.unsubscribe(h);
+    evt(6);
+    assert(log.size() == 2);
+}
+
+void test2()
+{
+    cout << "- Scan -" << endl;
+    event<int> evt;
+    vector<int> sums;
+    vector<size_t> counts;
+    auto h1 = evt |
+              ops::scan([](int sum, int n)
+                         { return sum + n; },
+                         100) |
+              ops::sink([&sums](int sum)
+                         { sums.push_back(sum); });
+    auto h2 = evt |
+              ops::filter([](int n)
+                           { return n > 1; }) |
+              ops::scan([](size_t count, int)
+                         { return count + 1; },
+                         size_t{0}) |
+              ops::map([](size_t count)
+                        { return count * 2; }) |
+              ops::sink([&counts](size_t count)
+                         { counts.push_back(count); });
+    evt(1);
+    evt(2);
+    evt(3);
+    assert((sums == vector<int>{101, 103, 106}));
+    assert((counts == vector<size_t>{2, 4}));
+    assert(evt.subscribed() == 2);
+    evt.unsubscribe(h1);
+    evt.unsubscribe(h2);
+}
+
+void test3()
+{
+    cout << "- Several callback arguments -" << endl;
+    event<int, const string &> evt;
+    vector<string> log;
+    auto h = evt |
+             ops::filter([](int n, const string &text)
+                          { return n > 0 && !text.empty(); }) |
+             ops::map([](int n, const string &text)
+                       { return text + ":" + to_string(n); }) |
+             ops::sink([&log](const string &text)
+                        { log.push_back(text); });
+    evt(1, "a");
+    evt(0, "b");
+    evt(2, "");
+    evt(3, "c");
+    assert((log == vector<string>{"a:1", "c:3"}));
+
+    // Sink only
+    int count = 0;
+    auto h2 = evt | ops::sink([&count](int, const string &)
+                               { count++; });
+    evt(4, "d");
+    assert(count == 1);
+    assert(log.size() == 3);
+    evt.unsubscribe(h);
+    evt.unsubscribe(h2);
+}
+
+void test4()
+{
+    cout << "- Observables -" << endl;
+    observable<int> value{0};
+    vector<int> log;
+    auto h = value.on_change |
+             ops::map([](void *, const int &n)
+                       { return n; }) |
+             ops::scan([](int max, int n)
+                        { return (n > max) ? n : max; },
+                        0) |
+             ops::sink([&log](int max)
+                        { log.push_back(max); });
+    value = 3;
+    value = 1;
+    value = 5;
+    assert((log == vector<int>{3, 3, 5}));
+    assert(h.is_subscribed());
+}
+
+void test5()
+{
+    cout << "- Move-only values between stages -" << endl;
+    event<int> evt;
+    int total = 0;
+    auto h = evt |
+             ops::map([](int n)
+                       { return make_unique<int>(n); }) |
+             ops::filter([](const unique_ptr<int> &p)
+                          { return *p > 1; }) |
+             ops::sink([&total](unique_ptr<int> p)
+                        { total += *p; });
+    evt(1);
+    evt(2);
+    evt(3);
+    assert(total == 5);
+    assert(h.is_subscribed());
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file rate_limit_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Throttle, debounce and sample adapters for events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "rate_limit.hpp"
+#include "observable.hpp"
+#include "../allocation_counter.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Throttle -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    event<int> source, downstream;
+    vector<int> log;
+    downstream += [&log](int n)
+    { log.push_back(n); };
+    throttler limiter(source, downstream, wheel, 100ms);
+    assert(limiter.interval() == 100ms);
+
+    // Leading edge
+    source(1);
+    assert((log == vector<int>{1}));
+    source(2);
+    source(3);
+    assert((log == vector<int>{1}));
+    assert(limiter.suppressed() == 1);
+
+    // Trailing edge
+    wheel.advance(start + 99ms);
+    assert((log == vector<int>{1}));
+    wheel.advance(start + 100ms);
+    assert((log == vector<int>{1, 3}));
+
+    // Window still open after the trailing edge
+    source(4);
+    assert((log == vector<int>{1, 3}));
+    wheel.advance(start + 200ms);
+    assert((log == vector<int>{1, 3, 4}));
+
+    // Nothing pending: window closes
+    wheel.advance(start + 300ms);
+    source(5);
+    assert((log == vector<int>{1, 3, 4, 5}));
+}
+
+void test2()
+{
+    cout << "- Debounce -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    event<int, const string &> source, downstream;
+    vector<pair<int, string>> log;
+    downstream += [&log](int n, const string &text)
+    { log.push_back({n, text}); };
+    debouncer limiter(source, downstream, wheel, 50ms);
+
+    for (int i = 0; i < 10; i++)
+    {
+        wheel.advance(start + i * 10ms);
+        source(i, to_string(i));
+    }
+    assert(log.empty());
+    // Last dispatch at 90ms
+    wheel.advance(start + 139ms);
+    assert(log.empty());
+    wheel.advance(start + 140ms);
+    assert((log == vector<pair<int, string>>{{9, "9"}}));
+    assert(limiter.suppressed() == 9);
+
+    wheel.advance(start + 1s);
+    assert(log.size() == 1);
+    assert(wheel.size() == 0);
+}
+
+void test3()
+{
+    cout << "- Sample -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    event<int> source, downstream;
+    vector<int> log;
+    downstream += [&log](int n)
+    { log.push_back(n); };
+    {
+        sampler limiter(source, downstream, wheel, 100ms);
+        source(1);
+        source(2);
+        wheel.advance(start + 100ms);
+        assert((log == vector<int>{2}));
+        // Nothing new
+        wheel.advance(start + 200ms);
+        assert((log == vector<int>{2}));
+        source(3);
+        wheel.advance(start + 300ms);
+        assert((log == vector<int>{2, 3}));
+        assert(wheel.size() == 1);
+    }
+    // Unsubscribed and cancelled on destruction
+    assert(source.subscribed() == 0);
+    assert(wheel.size() == 0);
+    source(4);
+    wheel.advance(start + 1s);
+    assert((log == vector<int>{2, 3}));
+}
+
+void test4()
+{
+    cout << "- Observables -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    observable<int> value{0};
+    observable<int>::event_type downstream;
+    vector<int> log;
+    downstream += [&log](void *, const int &n)
+    { log.push_back(n); };
+    debouncer limiter(value.on_change, downstream, wheel, 10ms);
+    value = 1;
+    value = 2;
+    value = 3;
+    wheel.advance(start + 10ms);
+    assert((log == vector<int>{3}));
+}
+
+void test5()
+{
+    cout << "- No allocation per dispatch -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    event<int, const string &> source, downstream;
+    size_t total = 0;
+    downstream += [&total](int, const string &text)
+    { total += text.size(); };
+    throttler t(source, downstream, wheel, 10ms);
+    debouncer d(source, downstream, wheel, 10ms);
+    sampler s(source, downstream, wheel, 10ms);
+    string text(64, 'x');
+    auto round = [&](int ms)
+    {
+        for (int n = 0; n < 10; n++)
+            source(n, text);
+        wheel.advance(start + ms * 1ms);
+    };
+
+    // Warm up: timer pool and payload storage
+    int i = 1;
+    for (; i <= 100; i++)
+        round(i);
+    size_t before = allocations.load();
+    for (; i <= 1000; i++)
+        round(i);
+    assert(allocations.load() == before);
+    assert(total > 0);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file spsc_channel_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Publish-subscribe pattern (one producer thread, one consumer thread)
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "spsc_channel.hpp"
+#include "event.hpp"
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Poll in the same thread -" << endl;
+    spsc_channel<int, const string &> channel(4);
+    vector<int> log;
+    auto sh = channel.subscribe([&log](int n, const string &text)
+                                { assert(text == to_string(n));
+                                  log.push_back(n); });
+    assert(sh.is_subscribed());
+    assert(channel.subscribed() == 1);
+    assert(channel.capacity() == 4);
+    assert(channel.poll() == 0);
+
+    channel(1, "1");
+    channel(2, "2");
+    channel(3, "3");
+    assert(log.empty());
+    assert(channel.poll(2) == 2);
+    assert((log == vector<int>{1, 2}));
+    assert(channel.poll() == 1);
+    assert((log == vector<int>{1, 2, 3}));
+
+    channel -= sh;
+    assert(!sh.is_subscribed());
+    channel(4, "4");
+    assert(channel.poll() == 1);
+    assert(log.size() == 3);
+}
+
+void test2()
+{
+    cout << "- Try dispatch -" << endl;
+    spsc_channel<int> channel(3);
+    int sum = 0;
+    channel += [&sum](int n)
+    { sum += n; };
+    assert(channel.capacity() == 4);
+    for (int i = 1; i <= 4; i++)
+        assert(channel.try_dispatch(i));
+    assert(!channel.try_dispatch(5));
+    assert(channel.poll() == 4);
+    assert(sum == 10);
+    assert(channel.try_dispatch(5));
+    assert(channel.poll() == 1);
+    assert(sum == 15);
+}
+
+void test3()
+{
+    cout << "- Consumer thread -" << endl;
+    constexpr int count = 20000;
+    for (auto strategy : {wait_strategy::busy_spin,
+                          wait_strategy::yield,
+                          wait_strategy::block,
+                          wait_strategy::adaptive})
+    {
+        spsc_channel<int> channel(64, strategy);
+        int expected = 0;
+        bool in_order = true;
+        channel += [&](int n)
+        {
+            in_order = in_order && (n == expected);
+            expected++;
+        };
+        thread consumer([&channel]()
+                        {
+                            size_t delivered = 0;
+                            while (delivered < count)
+                                delivered += channel.wait_and_poll();
+                        });
+        for (int i = 0; i < count; i++)
+            channel(i);
+        consumer.join();
+        assert(in_order);
+        assert(expected == count);
+    }
+}
+
+void test4()
+{
+    cout << "- Fed from an event -" << endl;
+    event<int> source;
+    spsc_channel<int> channel;
+    vector<int> log;
+    channel += [&log](int n)
+    { log.push_back(n); };
+    source += ref(channel);
+    for (int i = 0; i < 5; i++)
+        source(i);
+    assert(channel.poll() == 5);
+    assert((log == vector<int>{0, 1, 2, 3, 4}));
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
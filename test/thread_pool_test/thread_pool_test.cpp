@@ -0,0 +1,187 @@
+/**
+ * @file thread_pool_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Execution of callbacks in a pool of threads
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "thread_pool.hpp"
+#include "event.hpp"
+#include <cassert>
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Auxiliary
+//------------------------------------------------------------------------------
+
+void wait_for(atomic<int> &counter, int expected)
+{
+    while (counter.load() < expected)
+        this_thread::yield();
+}
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Run tasks posted from outside -" << endl;
+    thread_pool pool(4);
+    assert(pool.size() == 4);
+    atomic<int> counter{0};
+    for (int i = 0; i < 10000; i++)
+        pool.post([&counter]()
+                  { counter++; });
+    wait_for(counter, 10000);
+    assert(counter == 10000);
+}
+
+void test2()
+{
+    cout << "- Run tasks posted by workers (stealing) -" << endl;
+    thread_pool pool(4);
+    // A single worker would wait for itself
+    if (pool.size() < 2)
+        return;
+    atomic<int> counter{0};
+    atomic<int> done{0};
+    mutex ids_mutex;
+    set<thread::id> ids;
+    thread::id poster{};
+    pool.post([&]()
+              {
+                  poster = this_thread::get_id();
+                  // More tasks than the initial capacity of a worker's queue,
+                  // pushed to the queue of this worker
+                  for (int i = 0; i < 5000; i++)
+                      pool.post([&]()
+                                {
+                                    {
+                                        lock_guard<mutex> guard(ids_mutex);
+                                        ids.insert(this_thread::get_id());
+                                    }
+                                    counter++; });
+                  // Block this worker: other workers must steal
+                  wait_for(counter, 5000);
+                  done++; });
+    wait_for(done, 1);
+    assert(counter == 5000);
+    assert(!ids.empty());
+    assert(ids.count(poster) == 0);
+    assert(ids.count(this_thread::get_id()) == 0);
+}
+
+void test3()
+{
+    cout << "- Pending tasks are executed on destruction -" << endl;
+    atomic<int> counter{0};
+    {
+        thread_pool pool(2, true);
+        for (int i = 0; i < 1000; i++)
+            pool.post([&counter]()
+                      { counter++; });
+    }
+    assert(counter == 1000);
+}
+
+void test4()
+{
+    cout << "- Shared pool as an event executor -" << endl;
+    thread_pool &pool = thread_pool::shared();
+    assert(&pool == &thread_pool::shared());
+    assert(pool.size() >= 1);
+
+    event<int> evt;
+    atomic<int> sum{0};
+    atomic<int> calls{0};
+    evt.subscribe(
+        [&](int value)
+        {
+            sum += value;
+            calls++;
+        },
+        pool);
+    for (int i = 1; i <= 100; i++)
+        evt(i);
+    wait_for(calls, 100);
+    assert(sum == 5050);
+}
+
+void test5()
+{
+    cout << "- Idle wait strategies -" << endl;
+    for (auto strategy : {wait_strategy::yield,
+                          wait_strategy::block,
+                          wait_strategy::adaptive})
+    {
+        thread_pool pool(2, false, strategy);
+        atomic<int> counter{0};
+        for (int i = 0; i < 20; i++)
+        {
+            // Let workers go idle between tasks
+            this_thread::sleep_for(chrono::microseconds(200));
+            pool.post([&counter]()
+                      { counter++; });
+        }
+        wait_for(counter, 20);
+        assert(counter == 20);
+    }
+}
+
+void test6()
+{
+    cout << "- No task is lost by parked workers -" << endl;
+    struct witness
+    {
+        atomic<int> *alive;
+        witness(atomic<int> &alive) : alive{&alive} { alive++; }
+        witness(const witness &other) : alive{other.alive} { (*alive)++; }
+        ~witness() { (*alive)--; }
+    };
+    atomic<int> alive{0};
+    atomic<int> counter{0};
+    {
+        thread_pool pool(4, false, wait_strategy::block);
+        for (int round = 1; round <= 50; round++)
+        {
+            // Let workers park between bursts
+            this_thread::sleep_for(chrono::microseconds(500));
+            for (int i = 0; i < 20; i++)
+                pool.post([&counter, w = witness(alive)]()
+                          { counter++; });
+            auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+            while ((counter.load() < round * 20) &&
+                   (chrono::steady_clock::now() < deadline))
+                this_thread::yield();
+            assert(counter == round * 20);
+        }
+    }
+    assert(counter == 1000);
+    assert(alive == 0);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    test6();
+    return 0;
+}
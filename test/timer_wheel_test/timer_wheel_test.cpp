@@ -0,0 +1,256 @@
+/**
+ * @file timer_wheel_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Delayed and periodic dispatch of events
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "timer_wheel.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Expiration at every level -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    vector<int> log;
+    wheel.schedule_after(5ms, [&log]()
+                         { log.push_back(1); });
+    wheel.schedule_after(300ms, [&log]()
+                         { log.push_back(2); });
+    wheel.schedule_after(70s, [&log]()
+                         { log.push_back(3); });
+    wheel.schedule_at(start + 5h, [&log]()
+                      { log.push_back(4); });
+    assert(wheel.size() == 4);
+
+    assert(wheel.advance(start + 4ms) == 0);
+    assert(wheel.advance(start + 5ms) == 1);
+    assert(wheel.advance(start + 299ms) == 0);
+    assert(wheel.advance(start + 300ms) == 1);
+    assert(wheel.advance(start + 69999ms) == 0);
+    assert(wheel.advance(start + 70s) == 1);
+    assert(wheel.advance(start + 5h - 1ms) == 0);
+    assert(wheel.advance(start + 5h) == 1);
+    assert((log == vector<int>{1, 2, 3, 4}));
+    assert(wheel.size() == 0);
+
+    // Time never goes back
+    assert(wheel.advance(start) == 0);
+    assert(wheel.now() == start + 5h);
+}
+
+void test2()
+{
+    cout << "- Cancel -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    int count = 0;
+    auto h1 = wheel.schedule_after(10ms, [&count]()
+                                   { count++; });
+    auto h2 = wheel.schedule_after(1000ms, [&count]()
+                                   { count += 10; });
+    assert(h1.is_valid() && h2.is_valid());
+    assert(wheel.is_armed(h1) && wheel.is_armed(h2));
+
+    assert(wheel.cancel(h2));
+    assert(!h2.is_valid());
+    assert(!wheel.cancel(h2));
+    assert(wheel.size() == 1);
+
+    assert(wheel.advance(start + 2s) == 1);
+    assert(count == 1);
+    assert(!wheel.is_armed(h1));
+    assert(!wheel.cancel(h1));
+
+    // A stale handler does not cancel a new timer in a reused slot
+    auto stale = wheel.schedule_after(10ms, [&count]()
+                                      { count++; });
+    auto copy = stale;
+    assert(wheel.cancel(stale));
+    auto h3 = wheel.schedule_after(10ms, [&count]()
+                                   { count++; });
+    assert(!wheel.cancel(copy));
+    assert(wheel.is_armed(h3));
+    assert(wheel.advance(start + 3s) == 1);
+    assert(count == 2);
+
+    timer_wheel::timer_handle invalid;
+    assert(!invalid.is_valid());
+    assert(!wheel.cancel(invalid));
+}
+
+void test3()
+{
+    cout << "- Periodic timers -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    int count = 0;
+    timer_wheel::timer_handle h;
+    h = wheel.schedule_every(10ms, [&]()
+                             {
+                                 count++;
+                                 if (count == 15)
+                                     assert(wheel.cancel(h)); });
+    for (int i = 1; i <= 100; i++)
+        wheel.advance(start + i * 1ms);
+    assert(count == 10);
+    assert(wheel.is_armed(h));
+    // Late advance: missed periods are skipped
+    assert(wheel.advance(start + 1s) == 1);
+    assert(count == 11);
+    assert(wheel.advance(start + 1009ms) == 0);
+    for (int i = 1; i <= 4; i++)
+        assert(wheel.advance(start + 1000ms + i * 10ms) == 1);
+    assert(count == 15);
+    assert(wheel.size() == 0);
+    assert(wheel.advance(start + 2s) == 0);
+}
+
+void test4()
+{
+    cout << "- Event dispatch -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    event<int, const string &> evt;
+    vector<pair<int, string>> log;
+    evt += [&log](int n, const string &text)
+    { log.push_back({n, text}); };
+
+    string text = "later";
+    wheel.dispatch_after(20ms, evt, 2, text);
+    text = "changed";
+    wheel.dispatch_at(start + 10ms, evt, 1, "sooner");
+    auto h = wheel.dispatch_every(50ms, evt, 3, "heartbeat");
+    assert(wheel.advance(start + 50ms) == 3);
+    assert(wheel.advance(start + 100ms) == 1);
+    assert(wheel.cancel(h));
+    assert(wheel.advance(start + 200ms) == 0);
+    assert((log == vector<pair<int, string>>{
+                       {1, "sooner"},
+                       {2, "later"},
+                       {3, "heartbeat"},
+                       {3, "heartbeat"}}));
+}
+
+void test5()
+{
+    cout << "- Many timers -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    constexpr int count = 100000;
+    vector<int64_t> expired;
+    expired.reserve(count);
+    int64_t now_ms = 0;
+    vector<timer_wheel::timer_handle> handles;
+    handles.reserve(count);
+    uint32_t seed = 12345;
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        int64_t delay = seed % 100000;
+        handles.push_back(wheel.schedule_after(
+            chrono::milliseconds(delay),
+            [&expired, &now_ms, delay]()
+            {
+                // Never early, late up to the advance() period
+                assert(now_ms >= delay);
+                assert(now_ms - delay < 7);
+                expired.push_back(delay);
+            }));
+    }
+    // Cancel one in ten
+    for (int i = 0; i < count; i += 10)
+        assert(wheel.cancel(handles[i]));
+    assert(wheel.size() == count - count / 10);
+
+    for (now_ms = 0; now_ms <= 100000; now_ms += 7)
+        wheel.advance(start + chrono::milliseconds(now_ms));
+    wheel.advance(start + 101s);
+    assert(expired.size() == count - count / 10);
+    for (size_t i = 1; i < expired.size(); i++)
+        assert(expired[i - 1] <= expired[i]);
+    assert(wheel.size() == 0);
+}
+
+void test6()
+{
+    cout << "- Scheduling from a task -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    vector<int> log;
+    timer_wheel::timer_handle retry = wheel.schedule_after(30ms, [&log]()
+                                                           { log.push_back(-1); });
+    wheel.schedule_after(10ms, [&]()
+                         {
+                             log.push_back(1);
+                             // Relative to the time given to advance()
+                             wheel.schedule_after(5ms, [&log]()
+                                                  { log.push_back(2); });
+                             assert(wheel.cancel(retry)); });
+    assert(wheel.advance(start + 12ms) == 1);
+    assert(wheel.advance(start + 16ms) == 0);
+    assert(wheel.advance(start + 17ms) == 1);
+    assert(wheel.advance(start + 1s) == 0);
+    assert((log == vector<int>{1, 2}));
+}
+
+void test7()
+{
+    cout << "- Scheduling from another thread -" << endl;
+    auto start = timer_wheel::clock::now();
+    timer_wheel wheel(1ms, start);
+    atomic<int> count{0};
+    thread scheduler(
+        [&wheel, &count]()
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                auto h = wheel.schedule_after(1ms, [&count]()
+                                              { count++; });
+                if (i % 2)
+                    wheel.cancel(h);
+            }
+        });
+    for (int i = 1; i <= 200; i++)
+        wheel.advance(start + i * 1ms);
+    scheduler.join();
+    wheel.advance(start + 1s);
+    assert(wheel.size() == 0);
+    assert(count >= 500);
+    assert(count <= 1000);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    test6();
+    test7();
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file wait_strategy_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Waiting for another thread to make progress
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "wait_strategy.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Wake on progress -" << endl;
+    for (auto strategy : {wait_strategy::busy_spin,
+                          wait_strategy::yield,
+                          wait_strategy::block,
+                          wait_strategy::adaptive})
+    {
+        wait_point point;
+        atomic<int> progress{0};
+        thread other([&point, &progress]()
+                     {
+                         for (int i = 1; i <= 100; i++)
+                         {
+                             this_thread::sleep_for(chrono::microseconds(100));
+                             progress.store(i, memory_order_seq_cst);
+                             point.notify();
+                         }
+                     });
+        waiter w(strategy);
+        assert(w.strategy() == strategy);
+        for (int i = 1; i <= 100; i++)
+            w.wait(point, [&progress, i]()
+                   { return progress.load(memory_order_seq_cst) >= i; });
+        other.join();
+        assert(progress == 100);
+    }
+}
+
+void test2()
+{
+    cout << "- Adaptive spin time -" << endl;
+    wait_point point;
+    waiter w(wait_strategy::adaptive);
+    assert(w.spin_time() == waiter::max_spin_time);
+
+    // Long waits: spinning is wasted
+    for (int i = 0; i < 30; i++)
+        w.adapt(chrono::milliseconds(1));
+    assert(w.spin_time() == chrono::nanoseconds::zero());
+
+    // Short waits: spinning catches them
+    for (int i = 0; i < 100; i++)
+        w.adapt(chrono::microseconds(1));
+    assert(w.spin_time() > chrono::nanoseconds::zero());
+    assert(w.spin_time() < waiter::max_spin_time);
+
+    // Adaptation on wait
+    waiter other(wait_strategy::adaptive);
+    for (int i = 0; i < 30; i++)
+    {
+        atomic<bool> done{false};
+        thread notifier([&point, &done]()
+                        {
+                            this_thread::sleep_for(chrono::milliseconds(1));
+                            done.store(true, memory_order_seq_cst);
+                            point.notify();
+                        });
+        other.wait(point, [&done]()
+                   { return done.load(memory_order_seq_cst); });
+        notifier.join();
+    }
+    assert(other.spin_time() == chrono::nanoseconds::zero());
+}
+
+void test3()
+{
+    cout << "- Condition is not checked again once met -" << endl;
+    for (auto strategy : {wait_strategy::busy_spin,
+                          wait_strategy::yield,
+                          wait_strategy::block,
+                          wait_strategy::adaptive})
+        // Note: nobody notifies, so the condition must be met
+        // before sleeping (the second check at most)
+        for (int met_at = 1; met_at <= 2; met_at++)
+        {
+            wait_point point;
+            waiter w(strategy);
+            int calls = 0;
+            bool met = false;
+            w.wait(point, [&calls, &met, met_at]()
+                   {
+                       assert(!met);
+                       met = (++calls >= met_at);
+                       return met; });
+            assert(calls == met_at);
+        }
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    return 0;
+}
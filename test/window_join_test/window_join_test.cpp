@@ -0,0 +1,247 @@
+/**
+ * @file window_join_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Keyed join of two events within a window of time
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "window_join.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//------------------------------------------------------------------------------
+// Manual clock
+//------------------------------------------------------------------------------
+
+struct manual_clock
+{
+    using duration = chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = chrono::time_point<manual_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        return current;
+    }
+
+    static void set(int ms) noexcept
+    {
+        current = time_point(duration(ms));
+    }
+
+    static inline time_point current{};
+};
+
+struct request
+{
+    int id;
+    string path;
+};
+
+struct response
+{
+    int id;
+    int status;
+};
+
+struct tracked
+{
+    inline static int alive = 0;
+    int id;
+
+    tracked(int id) : id{id} { alive++; }
+    tracked(const tracked &other) : id{other.id} { alive++; }
+    ~tracked() { alive--; }
+};
+
+using join_type = window_join<int, request, response, manual_clock>;
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- One to one -" << endl;
+    manual_clock::set(0);
+    event<const request &> requests;
+    event<const response &> responses;
+    join_type::event_type matched;
+    vector<pair<string, int>> log;
+    matched += [&log](const request &req, const response &res)
+    { log.push_back({req.path, res.status}); };
+    join_type join(
+        matched,
+        requests, [](const request &r)
+        { return r.id; },
+        responses, [](const response &r)
+        { return r.id; },
+        100ms,
+        join_mode::one_to_one);
+
+    requests({1, "/a"});
+    requests({2, "/b"});
+    assert(join.size() == 2);
+    manual_clock::set(10);
+    responses({2, 200});
+    assert((log == vector<pair<string, int>>{{"/b", 200}}));
+    assert(join.size() == 1);
+    // Responses may arrive first
+    responses({3, 404});
+    requests({3, "/c"});
+    assert(log.back() == make_pair(string("/c"), 404));
+    assert(join.size() == 1);
+    // Duplicate response does not match again
+    responses({2, 500});
+    assert(log.size() == 2);
+    assert(join.size() == 2);
+
+    // Expiration
+    manual_clock::set(100);
+    responses({1, 200});
+    assert(log.size() == 2);
+    assert(join.evicted() == 1);
+    join.advance(manual_clock::time_point(110ms));
+    assert(join.evicted() == 2);
+    join.advance(manual_clock::time_point(200ms));
+    assert(join.size() == 0);
+    assert(join.evicted() == 3);
+}
+
+void test2()
+{
+    cout << "- Many to many -" << endl;
+    manual_clock::set(0);
+    event<string> left;
+    event<const string &> right;
+    window_join<char, string, string, manual_clock>::event_type matched;
+    vector<string> log;
+    matched += [&log](const string &l, const string &r)
+    { log.push_back(l + "+" + r); };
+    auto first_letter = [](const string &s)
+    { return s[0]; };
+    window_join<char, string, string, manual_clock> join(
+        matched, left, first_letter, right, first_letter, 50ms);
+
+    left("a1");
+    left("a2");
+    left("b1");
+    manual_clock::set(20);
+    right("a3");
+    sort(log.begin(), log.end());
+    assert((log == vector<string>{"a1+a3", "a2+a3"}));
+    log.clear();
+    manual_clock::set(30);
+    left("a4");
+    assert((log == vector<string>{"a4+a3"}));
+    log.clear();
+    // a1, a2 and b1 expire
+    manual_clock::set(60);
+    right("a5");
+    assert((log == vector<string>{"a4+a5"}));
+    assert(join.evicted() == 3);
+    assert(join.size() == 3);
+}
+
+void test3()
+{
+    cout << "- Bounded memory -" << endl;
+    manual_clock::set(0);
+    event<const request &> requests;
+    event<const response &> responses;
+    join_type::event_type matched;
+    int count = 0;
+    matched += [&count](const request &req, const response &res)
+    {
+        assert(req.id == res.id);
+        count++;
+    };
+    join_type join(
+        matched,
+        requests, [](const request &r)
+        { return r.id; },
+        responses, [](const response &r)
+        { return r.id; },
+        10ms,
+        join_mode::one_to_one,
+        64);
+
+    // Window: at most 10 ms of requests are kept
+    for (int i = 0; i < 10000; i++)
+    {
+        manual_clock::set(i);
+        requests({i, "/"});
+        if (i % 2)
+            responses({i - 1, 200});
+        assert(join.size() <= 10);
+    }
+    assert(count == 5000);
+    assert(join.evicted() > 4000);
+
+    // Capacity: at most 64 requests are kept
+    manual_clock::set(20000);
+    for (int i = 0; i < 1000; i++)
+        requests({20000 + i, "/"});
+    assert(join.size() == 64);
+    responses({20000 + 999, 200});
+    responses({20000, 200});
+    assert(count == 5001);
+}
+
+void test4()
+{
+    cout << "- Matched values are released -" << endl;
+    manual_clock::set(0);
+    event<const tracked &> requests;
+    event<const tracked &> responses;
+    window_join<int, tracked, tracked, manual_clock>::event_type matched;
+    int count = 0;
+    matched += [&count](const tracked &req, const tracked &res)
+    {
+        assert(req.id == res.id);
+        count++;
+    };
+    auto id_of = [](const tracked &t)
+    { return t.id; };
+    window_join<int, tracked, tracked, manual_clock> join(
+        matched, requests, id_of, responses, id_of,
+        1000s, join_mode::one_to_one, 8);
+
+    // An unanswered request stays at the front
+    requests(tracked(-1));
+    for (int i = 0; i < 10000; i++)
+    {
+        requests(tracked(i));
+        responses(tracked(i));
+        assert(tracked::alive <= 2 * 8 + 1);
+    }
+    assert(count == 10000);
+    assert(join.size() == 1);
+    assert(join.evicted() == 0);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file window_test.cpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain. 2026.
+ * @brief Windowed aggregation of event data
+ * @date 2026-10-18
+ *
+ * @copyright EUPL 1.2 License
+ */
+
+#include "window.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+//------------------------------------------------------------------------------
+// Manual clock
+//------------------------------------------------------------------------------
+
+struct manual_clock
+{
+    using duration = chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = chrono::time_point<manual_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        return current;
+    }
+
+    static void set(int ms) noexcept
+    {
+        current = time_point(duration(ms));
+    }
+
+    static inline time_point current{};
+};
+
+/// @brief Concatenation (not commutative)
+struct concat_aggregate
+{
+    using value_type = string;
+    using state_type = string;
+    using result_type = string;
+    static string identity() { return {}; }
+    static string lift(const string &value) { return value; }
+    static string combine(const string &a, const string &b) { return a + b; }
+    static string lower(const string &s) { return s; }
+};
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+
+void test1()
+{
+    cout << "- Tumbling window -" << endl;
+    manual_clock::set(0);
+    event<int> source;
+    tumbling_window<sum_aggregate<int>, manual_clock>::event_type downstream;
+    vector<int> log;
+    downstream += [&log](const int &sum)
+    { log.push_back(sum); };
+    tumbling_window<sum_aggregate<int>, manual_clock> window(downstream, source, 100ms);
+
+    manual_clock::set(10);
+    source(1);
+    manual_clock::set(99);
+    source(2);
+    assert(log.empty());
+    manual_clock::set(100);
+    source(10);
+    assert((log == vector<int>{3}));
+    // Empty windows are not dispatched
+    manual_clock::set(450);
+    source(20);
+    assert((log == vector<int>{3, 10}));
+    window.advance(manual_clock::time_point(499ms));
+    assert(log.size() == 2);
+    window.advance(manual_clock::time_point(500ms));
+    assert((log == vector<int>{3, 10, 20}));
+    window.advance(manual_clock::time_point(1000ms));
+    assert(log.size() == 3);
+}
+
+void test2()
+{
+    cout << "- Sliding window -" << endl;
+    manual_clock::set(0);
+    event<int> source;
+    sliding_window<max_aggregate<int>, manual_clock>::event_type downstream;
+    vector<int> log;
+    downstream += [&log](const int &max)
+    { log.push_back(max); };
+    sliding_window<max_aggregate<int>, manual_clock> window(downstream, source, 100ms);
+
+    manual_clock::set(0);
+    source(5);
+    manual_clock::set(50);
+    source(3);
+    manual_clock::set(80);
+    source(4);
+    assert((log == vector<int>{5, 5, 5}));
+    assert(window.size() == 3);
+    // 5 expires
+    manual_clock::set(100);
+    source(1);
+    assert(log.back() == 4);
+    assert(window.size() == 3);
+    // 3 and 4 expire
+    window.advance(manual_clock::time_point(180ms));
+    assert(log.back() == 1);
+    assert(window.size() == 1);
+    // Nothing expires: nothing dispatched
+    window.advance(manual_clock::time_point(190ms));
+    assert(log.size() == 5);
+    window.advance(manual_clock::time_point(200ms));
+    assert(log.back() == numeric_limits<int>::lowest());
+    assert(window.size() == 0);
+}
+
+void test3()
+{
+    cout << "- Sliding window (order and amortization) -" << endl;
+    manual_clock::set(0);
+    event<const string &> source;
+    sliding_window<concat_aggregate, manual_clock, no_lock>::event_type downstream;
+    string last;
+    downstream += [&last](const string &text)
+    { last = text; };
+    sliding_window<concat_aggregate, manual_clock, no_lock> window(downstream, source, 3ms);
+    string letters = "abcdefghij";
+    for (int i = 0; i < 10; i++)
+    {
+        manual_clock::set(i);
+        source(letters.substr(i, 1));
+        // The last three values, oldest first
+        assert(last == letters.substr((i < 2) ? 0 : i - 2, (i < 2) ? i + 1 : 3));
+    }
+
+    // Compare against brute force
+    sliding_window<sum_aggregate<long long>, manual_clock, no_lock>::event_type sums;
+    long long sum = 0;
+    sums += [&sum](const long long &s)
+    { sum = s; };
+    event<long long> wide;
+    sliding_window<sum_aggregate<long long>, manual_clock, no_lock> summed(sums, wide, 50ms);
+    vector<pair<int, long long>> all;
+    uint32_t seed = 7;
+    int now = 1000;
+    for (int i = 0; i < 10000; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        now += seed % 10;
+        long long value = seed % 1000;
+        manual_clock::set(now);
+        wide(value);
+        all.push_back({now, value});
+        long long expected = 0;
+        for (auto it = all.rbegin(); it != all.rend() && (now - it->first < 50); ++it)
+            expected += it->second;
+        assert(sum == expected);
+    }
+}
+
+void test4()
+{
+    cout << "- Session window -" << endl;
+    manual_clock::set(0);
+    observable<double> source;
+    session_window<mean_aggregate<double>, manual_clock>::event_type downstream;
+    vector<double> log;
+    downstream += [&log](const double &mean)
+    { log.push_back(mean); };
+    session_window<mean_aggregate<double>, manual_clock> window(downstream, source, 30ms);
+
+    manual_clock::set(0);
+    source = 1.0;
+    manual_clock::set(20);
+    source = 2.0;
+    manual_clock::set(40);
+    source = 3.0;
+    assert(log.empty());
+    // Gap
+    manual_clock::set(70);
+    source = 10.0;
+    assert((log == vector<double>{2.0}));
+    window.advance(manual_clock::time_point(99ms));
+    assert(log.size() == 1);
+    window.advance(manual_clock::time_point(100ms));
+    assert((log == vector<double>{2.0, 10.0}));
+    window.advance(manual_clock::time_point(1000ms));
+    assert(log.size() == 2);
+}
+
+void test5()
+{
+    cout << "- Count, sum, min, max, mean -" << endl;
+    using state = pair<double, size_t>;
+    assert(count_aggregate<int>::combine(count_aggregate<int>::lift(7), 2) == 3);
+    assert(sum_aggregate<int>::combine(1, sum_aggregate<int>::identity()) == 1);
+    assert(min_aggregate<int>::combine(min_aggregate<int>::identity(), 4) == 4);
+    assert(max_aggregate<int>::combine(-4, max_aggregate<int>::identity()) == -4);
+    assert(mean_aggregate<int>::lower(mean_aggregate<int>::identity()) == 0.0);
+    assert(mean_aggregate<int>::lower(state{6.0, 4}) == 1.5);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+int main()
+{
+    test1();
+    test2();
+    test3();
+    test4();
+    test5();
+    return 0;
+}